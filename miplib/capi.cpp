@@ -56,6 +56,10 @@ Var::Type convert_var_type(miplib_VarType type)
       return Var::Type::Binary;
     case miplib_VarType::Integer:
       return Var::Type::Integer;
+    case miplib_VarType::SemiContinuous:
+      return Var::Type::SemiContinuous;
+    case miplib_VarType::SemiInteger:
+      return Var::Type::SemiInteger;
   }
   throw std::logic_error("Unsupported var type.");
 }
@@ -88,6 +92,33 @@ int miplib_shallow_copy_solver(miplib::Solver** rp_solver, miplib::Solver* p_sol
   END
 }
 
+int miplib_clone_solver(
+  miplib::Solver** rp_solver, miplib::Solver::Remapping** rp_remapping, miplib::Solver* p_solver
+)
+{
+  BEGIN
+  auto [solver, remapping] = p_solver->clone();
+  *rp_solver = new Solver(solver);
+  *rp_remapping = new Solver::Remapping(remapping);
+  END
+}
+
+int miplib_destroy_remapping(miplib::Solver::Remapping* p_remapping)
+{
+  BEGIN
+  delete p_remapping;
+  END
+}
+
+int miplib_remap_var(
+  miplib::Var** rp_var, miplib::Solver::Remapping* p_remapping, miplib::Var* p_var
+)
+{
+  BEGIN
+  *rp_var = new miplib::Var(p_remapping->var(*p_var));
+  END
+}
+
 int miplib_create_var(miplib::Var** rp_var, miplib::Solver* p_solver, miplib_VarType type)
 {
   BEGIN
@@ -10,13 +10,20 @@ enum miplib_SolverBackend {
 };
 
 enum class miplib_VarType { 
-  Continuous = 0, Binary = 1, Integer = 2
+  Continuous = 0, Binary = 1, Integer = 2, SemiContinuous = 3, SemiInteger = 4
 };
 
 char const* miplib_get_last_error();
 int miplib_create_solver(miplib::Solver** rp_solver, miplib_SolverBackend backend);
 int miplib_destroy_solver(miplib::Solver* p_solver);
 int miplib_shallow_copy_solver(miplib::Solver** rp_solver, miplib::Solver* p_solver);
+int miplib_clone_solver(
+  miplib::Solver** rp_solver, miplib::Solver::Remapping** rp_remapping, miplib::Solver* p_solver
+);
+int miplib_destroy_remapping(miplib::Solver::Remapping* p_remapping);
+int miplib_remap_var(
+  miplib::Var** rp_var, miplib::Solver::Remapping* p_remapping, miplib::Var* p_var
+);
 
 int miplib_create_var(miplib::Var** rp_var, miplib::Solver* p_solver, miplib_VarType type);
 int miplib_destroy_var(miplib::Var* p_var);
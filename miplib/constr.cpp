@@ -1,6 +1,11 @@
 #include "constr.hpp"
 #include "solver.hpp"
 #include <miplib/util/scale.hpp>
+#include <miplib/util/subexpressions.hpp>
+
+#include <algorithm>
+#include <future>
+#include <numeric>
 
 namespace miplib {
 
@@ -14,6 +19,19 @@ Constr::Constr(
 {
 }
 
+Constr::Constr(
+  Solver const& solver,
+  Expr const& e,
+  double width,
+  std::optional<std::string> const& name):
+  p_impl(solver.p_impl->create_constr(Constr::Range, e, name)
+)
+{
+  if (width < 0)
+    throw std::logic_error("Attempt to create a range constraint with negative width.");
+  p_impl->m_width = width;
+}
+
 Expr Constr::expr() const
 {
   return p_impl->m_expr;
@@ -24,83 +42,129 @@ Constr::Type Constr::type() const
   return p_impl->m_type;
 }
 
+double Constr::width() const
+{
+  return p_impl->m_width;
+}
+
 std::optional<std::string> const& Constr::name() const
 {
   return p_impl->m_name;
 }
 
-bool Constr::must_be_satisfied() const
+// The checks below work on the bounds of the constraint expression so that
+// callers needing several of them compute those bounds only once.
+
+static bool must_be_satisfied(Constr const& constr, std::pair<double, double> const& bounds)
 {
-  auto const& e = expr();
-  double lb = e.lb();
-  double ub = e.ub();
+  auto const [lb, ub] = bounds;
   if (ub > 0) // FIXME: use eps
     return false;
-  if (type() == Type::LessEqual)
+  if (constr.type() == Constr::Type::LessEqual)
     return true;
-  if (lb < 0) // FIXME: use eps
+  if (lb < -constr.width()) // FIXME: use eps
     return false;
   return true;
 }
 
-bool Constr::must_be_violated() const
+static bool must_be_violated(Constr const& constr, std::pair<double, double> const& bounds)
 {
-  auto const& e = expr();
-  double lb = e.lb();
-  double ub = e.ub();
+  auto const [lb, ub] = bounds;
   if (lb > 0) // FIXME: use eps
     return true;
-  if (ub < 0 and type() == Type::Equal) // FIXME: use eps
+  if (constr.type() == Constr::Type::LessEqual)
+    return false;
+  if (ub < -constr.width()) // FIXME: use eps
     return true;
   return false;  
 }
 
-// If the truth value of the constraint can be captured as
-// a linear expression (without introducing extra variables).
-// A constraint is reifiable if its domain is either non-negative
-// or non-positive.
-bool Constr::is_reifiable() const
+// is_integer tells if the constraint expression must be integer.
+static bool is_reifiable(
+  Constr const& constr, std::pair<double, double> const& bounds, bool is_integer
+)
 {
-  auto const& e = expr();
-  if (type() != Type::Equal)
+  auto const [lb, ub] = bounds;
+  if (constr.type() != Constr::Type::Equal)
     return false;
-  if (!e.must_be_integer())
+  if (!is_integer)
     return false;
-  if (e.lb() * e.ub() < 0) // FIXME: use eps
+  if (lb * ub < 0) // FIXME: use eps
     return false;
   return true;
 }
 
-// Get the truth value of the constraint as a linear expression.
-Expr Constr::reified() const
+static Expr reified(
+  Constr const& constr, std::pair<double, double> const& bounds, bool is_integer
+)
 {
-  if (!is_reifiable())
+  if (!is_reifiable(constr, bounds, is_integer))
     throw std::logic_error("Attempt to reify non-reifiable constraint.");
-  if (must_be_violated())
+  if (must_be_violated(constr, bounds))
     throw std::logic_error("Attempt to reify a constraint that is trivially violated.");
-  if (must_be_satisfied())
+  if (must_be_satisfied(constr, bounds))
     throw std::logic_error("Attempt to reify a constraint that is trivially satisfied.");
 
-  auto const& e = expr();
-  double ub = e.ub();
+  auto const& e = constr.expr();
+  auto const [lb, ub] = bounds;
 
   if (ub > 0)
   {
-    assert(e.lb() == 0);
+    assert(lb == 0);
     return e;
   }
   else
   {
     assert(ub == 0);
-    assert(e.lb() < 0);
+    assert(lb < 0);
     return -e;
   }
 }
 
+bool Constr::must_be_satisfied() const
+{
+  return miplib::must_be_satisfied(*this, expr().bounds());
+}
+
+bool Constr::must_be_violated() const
+{
+  return miplib::must_be_violated(*this, expr().bounds());
+}
+
+bool Constr::is_convex() const
+{
+  auto const e = expr();
+  return e.is_linear() or (type() == Type::LessEqual and e.is_convex());
+}
+
+double Constr::dual() const
+{
+  return expr().solver().duals({*this}).front();
+}
+
+// If the truth value of the constraint can be captured as
+// a linear expression (without introducing extra variables).
+// A constraint is reifiable if its domain is either non-negative
+// or non-positive.
+bool Constr::is_reifiable() const
+{
+  if (type() != Type::Equal)
+    return false;
+  return miplib::is_reifiable(*this, expr().bounds(), expr().must_be_integer());
+}
+
+// Get the truth value of the constraint as a linear expression.
+Expr Constr::reified() const
+{
+  return miplib::reified(*this, expr().bounds(), expr().must_be_integer());
+}
+
 std::ostream& operator<<(std::ostream& os, Constr const& c)
 {
+  if (c.type() == Constr::Range)
+    os << -c.width() << " <= ";
   os << c.expr() << " ";
-  os << ((c.type() == Constr::LessEqual) ? "<= " : "= ");
+  os << ((c.type() == Constr::Equal) ? "= " : "<= ");
   os << 0;
   return os;
 }
@@ -142,11 +206,27 @@ Constr operator==(Expr const& e1, Expr const& e2)
   return Constr(*p_solver, Constr::Equal, e1 - e2);
 }
 
+Constr range(double lb, Expr const& e, double ub)
+{
+  if (e.is_constant())
+    throw std::logic_error("Attempt to create a constraint from constant expressions");
+  if (lb > ub)
+    throw std::logic_error("Attempt to create a range constraint with lb > ub.");
+  return Constr(e.solver(), e - ub, ub - lb);
+}
+
 Constr Constr::scale(double skip_lb, double skip_ub, bool ignore_inf_var_bounds) const
 {
   return detail::scale_gm(*this, skip_lb, skip_ub, ignore_inf_var_bounds);
 }
 
+std::vector<Constr> extract_common_subexpressions(
+  std::vector<Constr> const& constrs, std::size_t min_size
+)
+{
+  return detail::extract_common_subexpressions(constrs, min_size);
+}
+
 /**
  *  Indicator constraints
  **/
@@ -200,44 +280,107 @@ std::shared_ptr<detail::IIndicatorConstr> create_reformulatable_indicator_constr
 {
   return std::make_shared<IIndicatorConstr>(implicant, implicand, name);
 }
+
+std::shared_ptr<detail::IGenConstr> create_reformulatable_gen_constr(
+  GenConstr::Type const& type,
+  Var const& resultant,
+  std::vector<Var> const& operands,
+  std::optional<std::string> const& name
+)
+{
+  return std::make_shared<IGenConstr>(type, resultant, operands, name);
+}
+
+std::shared_ptr<detail::IPwlConstr> create_reformulatable_pwl_constr(
+  Var const& x,
+  Var const& y,
+  std::vector<double> const& xs,
+  std::vector<double> const& ys,
+  std::optional<std::string> const& name
+)
+{
+  return std::make_shared<IPwlConstr>(x, y, xs, ys, name);
+}
 } // namespace detail
 
-bool IndicatorConstr::has_reformulation() const
+// Big-M of the reformulation given the bounds of the implicand expression.
+static double big_m(
+  Constr const& implicand, std::pair<double, double> const& bounds, double infinity
+)
 {
-  if (!implicant().is_reifiable())
-    return false;
-  auto const& solver = implicand().expr().solver();
+  auto const [lb, ub] = bounds;
 
-  if (implicand().expr().ub() == solver.infinity())
-    return false;
+  if (ub == infinity)
+    return infinity;
+
+  double m = std::max(ub, 0.0);
   
-  if (implicand().type() == Constr::Type::LessEqual)
-    return true;
+  if (implicand.type() == Constr::Type::LessEqual)
+    return m;
   
-  assert(implicand().type() == Constr::Type::Equal);
-  if (implicand().expr().lb() == -solver.infinity())
+  if (lb == -infinity)
+    return infinity;
+
+  return std::max(m, -(lb + implicand.width()));
+}
+
+bool IndicatorConstr::has_reformulation() const
+{
+  if (!implicant().is_reifiable())
     return false;
+  auto const& solver = implicand().expr().solver();
+  return big_m() != solver.infinity();
+}
 
-  return true;
+double IndicatorConstr::big_m() const
+{
+  auto const& solver = implicand().expr().solver();
+  return miplib::big_m(implicand(), implicand().expr().bounds(), solver.infinity());
 }
 
+// What the reformulation of an indicator constraint depends on in the
+// backend, read beforehand so that reformulating does not query it.
+struct IndicatorReformulationInput
+{
+  std::pair<double, double> implicant_bounds;
+  bool implicant_is_integer;
+  std::pair<double, double> implicand_bounds;
+  double infinity;
+};
 
-std::vector<Constr> IndicatorConstr::reformulation() const
+static IndicatorReformulationInput reformulation_input(IndicatorConstr const& constr)
 {
-  if (!implicant().is_reifiable())
+  return {
+    constr.implicant().expr().bounds(),
+    constr.implicant().expr().must_be_integer(),
+    constr.implicand().expr().bounds(),
+    constr.implicand().expr().solver().infinity()
+  };
+}
+
+static std::vector<Constr> reformulation(
+  IndicatorConstr const& constr, IndicatorReformulationInput const& input
+)
+{
+  auto const& implicant = constr.implicant();
+  auto const& implicand = constr.implicand();
+  auto const& implicant_bounds = input.implicant_bounds;
+  if (!is_reifiable(implicant, implicant_bounds, input.implicant_is_integer))
     throw std::logic_error(
       "Attempt to reformulate indicator constraint with non reifiable implicant."
     );
 
-  auto const& solver = implicand().expr().solver();
+  double const infinity = input.infinity;
+  auto const [lb, ub] = input.implicand_bounds;
 
-  double ub = implicand().expr().ub();
-  if (ub == solver.infinity())
+  if (ub == infinity)
     throw std::logic_error(
       "Attempt to reformulate indicator constraint with unknown implicand upper bound."
       " Try bounding the domain of the involved variables."
     );
 
+  Expr const z = reified(implicant, implicant_bounds, input.implicant_is_integer);
+
   std::vector<Constr> r;
 
   // z = 1 -> LinExpr <= 0
@@ -245,15 +388,12 @@ std::vector<Constr> IndicatorConstr::reformulation() const
 
   // add ub reformulation if not redundant
   if (ub > 0) 
-    r.push_back(implicand().expr() <= ub * implicant().reified());
+    r.push_back(implicand.expr() <= ub * z);
 
-  if (implicand().type() == Constr::Type::LessEqual)
+  if (implicand.type() == Constr::Type::LessEqual)
     return r;
 
-  assert(implicand().type() == Constr::Type::Equal);
-
-  double lb = implicand().expr().lb();
-  if (lb == -solver.infinity())
+  if (lb == -infinity)
     throw std::logic_error(
       "Attempt to reformulate indicator constraint with unknown implicand lower bound."
       " Try bounding the domain of the involved variables."
@@ -263,13 +403,67 @@ std::vector<Constr> IndicatorConstr::reformulation() const
   // <-> z = 1 -> LinExpr <= 0 /\ z = 1 -> -LinExpr <= 0
   // <-> LinExpr - ub(LinExpr) * (1-z) <= 0 /\ -LinExpr - ub(-LinExpr) * (1-z) <= 0
   // <-> LinExpr - ub(LinExpr) * (1-z) <= 0 /\ -LinExpr + lb(LinExpr) * (1-z) <= 0
+  // A range implicand is handled alike, with its lower side shifted by its width.
 
-  if (lb < 0) 
-    r.push_back(lb * implicant().reified() <= implicand().expr());
+  double const w = implicand.width();
+  if (lb + w < 0)
+    r.push_back((lb + w) * z <= implicand.expr() + w);
 
   return r;
 }
 
+std::vector<Constr> IndicatorConstr::reformulation() const
+{
+  // bounds are computed once for the implicant and the implicand
+  // and shared by all the checks.
+  return miplib::reformulation(*this, reformulation_input(*this));
+}
+
+std::vector<Constr> reformulation(
+  std::vector<IndicatorConstr> const& constrs, std::size_t nr_threads
+)
+{
+  if (constrs.empty())
+    return {};
+
+  nr_threads = std::max<std::size_t>(1, std::min(nr_threads, constrs.size()));
+
+  // backends may not be queried from several threads at once (e.g. Gurobi
+  // models), hence the variable bounds and types are read beforehand and
+  // the threads only build the constraints.
+  std::vector<IndicatorReformulationInput> inputs;
+  for (auto const& constr: constrs)
+    inputs.push_back(reformulation_input(constr));
+
+  auto reformulate_range = [&](std::size_t begin, std::size_t end) {
+    std::vector<Constr> r;
+    for (std::size_t i = begin; i < end; ++i)
+      for (auto const& c: miplib::reformulation(constrs[i], inputs[i]))
+        r.push_back(c);
+    return r;
+  };
+
+  if (nr_threads == 1)
+    return reformulate_range(0, constrs.size());
+
+  std::vector<std::future<std::vector<Constr>>> chunks;
+  std::size_t const chunk_size = (constrs.size() + nr_threads - 1) / nr_threads;
+  for (std::size_t begin = 0; begin < constrs.size(); begin += chunk_size)
+    chunks.push_back(std::async(
+      std::launch::async,
+      reformulate_range,
+      begin,
+      std::min(begin + chunk_size, constrs.size())
+    ));
+
+  // concatenate in order, so the result does not depend on nr_threads.
+  std::vector<Constr> r;
+  for (auto& chunk: chunks)
+    for (auto const& c: chunk.get())
+      r.push_back(c);
+  return r;
+}
+
 std::vector<Constr> IndicatorConstr::scale(double skip_lb, double skip_ub) const
 {
   std::vector<Constr> r;
@@ -278,4 +472,475 @@ std::vector<Constr> IndicatorConstr::scale(double skip_lb, double skip_ub) const
   return r;
 }
 
+/**
+ *  SOS constraints
+ **/
+
+SOSConstr::SOSConstr(
+  Solver const& solver,
+  SOSConstr::Type const& type,
+  std::vector<Var> const& vars,
+  std::vector<double> const& weights,
+  std::optional<std::string> const& name
+)
+{
+  if (vars.empty())
+    throw std::logic_error("SOS constraint must have at least one variable.");
+  if (vars.size() != weights.size())
+    throw std::logic_error("SOS constraint must have as many weights as variables.");
+
+  // backends order the set by weight, so it is stored already sorted.
+  std::vector<std::size_t> idxs(vars.size());
+  std::iota(idxs.begin(), idxs.end(), 0);
+  std::stable_sort(idxs.begin(), idxs.end(), [&](auto i, auto j) {
+    return weights[i] < weights[j];
+  });
+
+  std::vector<Var> sorted_vars;
+  std::vector<double> sorted_weights;
+  for (auto i: idxs)
+  {
+    if (!sorted_weights.empty() and sorted_weights.back() == weights[i])
+      throw std::logic_error("SOS constraint weights must be distinct.");
+    sorted_vars.push_back(vars[i]);
+    sorted_weights.push_back(weights[i]);
+  }
+
+  p_impl = solver.p_impl->create_sos_constr(type, sorted_vars, sorted_weights, name);
+}
+
+static std::vector<double> default_sos_weights(std::size_t n)
+{
+  std::vector<double> weights(n);
+  std::iota(weights.begin(), weights.end(), 1.0);
+  return weights;
+}
+
+SOSConstr::SOSConstr(
+  Solver const& solver,
+  SOSConstr::Type const& type,
+  std::vector<Var> const& vars,
+  std::optional<std::string> const& name
+):
+  SOSConstr(solver, type, vars, default_sos_weights(vars.size()), name)
+{}
+
+SOSConstr::Type SOSConstr::type() const
+{
+  return p_impl->m_type;
+}
+
+std::vector<Var> const& SOSConstr::vars() const
+{
+  return p_impl->m_vars;
+}
+
+std::vector<double> const& SOSConstr::weights() const
+{
+  return p_impl->m_weights;
+}
+
+std::optional<std::string> const& SOSConstr::name() const
+{
+  return p_impl->m_name;
+}
+
+std::ostream& operator<<(std::ostream& os, SOSConstr const& c)
+{
+  os << ((c.type() == SOSConstr::SOS1) ? "SOS1(" : "SOS2(");
+  for (std::size_t i = 0; i < c.vars().size(); ++i)
+  {
+    if (i > 0)
+      os << ", ";
+    os << c.vars()[i] << ":" << c.weights()[i];
+  }
+  os << ")";
+  return os;
+}
+
+bool SOSConstr::has_reformulation() const
+{
+  auto const& solver = vars().front().solver();
+  for (auto const& v: vars())
+    if (v.domain_lb() == -solver.infinity() or v.domain_ub() == solver.infinity())
+      return false;
+  return true;
+}
+
+std::vector<Constr> SOSConstr::reformulation() const
+{
+  if (!has_reformulation())
+    throw std::logic_error(
+      "Attempt to reformulate SOS constraint with unbounded variables."
+      " Try bounding the domain of the involved variables."
+    );
+
+  std::vector<Constr> r;
+  auto const& xs = vars();
+  auto const& solver = xs.front().solver();
+
+  // b[i] = 0 -> xs[i] = 0 for SOS1,
+  // b[i] = 0 /\ b[i-1] = 0 -> xs[i] = 0 for SOS2 (b[i] covers xs[i] and xs[i+1]).
+  std::size_t const nr_bins = (type() == SOS1) ? xs.size() : xs.size() - 1;
+  if (nr_bins == 0)
+    return r;
+
+  std::vector<Var> bs;
+  Expr bs_sum;
+  for (std::size_t i = 0; i < nr_bins; ++i)
+  {
+    bs.emplace_back(solver, Var::Type::Binary);
+    bs_sum += bs.back();
+  }
+  r.push_back(bs_sum <= 1);
+
+  for (std::size_t i = 0; i < xs.size(); ++i)
+  {
+    Expr active;
+    if (type() == SOS1)
+      active = bs[i];
+    else
+    {
+      if (i > 0)
+        active += bs[i - 1];
+      if (i < nr_bins)
+        active += bs[i];
+    }
+
+    // add bound reformulations if not redundant
+    auto const& x = xs[i];
+    if (x.domain_ub() > 0)
+      r.push_back(x <= x.domain_ub() * active);
+    if (x.domain_lb() < 0)
+      r.push_back(x.domain_lb() * active <= x);
+  }
+
+  return r;
+}
+
+/**
+ *  General constraints
+ **/
+
+GenConstr::GenConstr(
+  Solver const& solver,
+  GenConstr::Type const& type,
+  Var const& resultant,
+  std::vector<Var> const& operands,
+  std::optional<std::string> const& name
+)
+{
+  if (operands.empty())
+    throw std::logic_error("General constraint must have at least one operand.");
+  if (type == Abs and operands.size() != 1)
+    throw std::logic_error("Abs constraint must have exactly one operand.");
+  if (type == And or type == Or)
+  {
+    if (!Expr(resultant).must_be_binary())
+      throw std::logic_error("And/Or constraints require binary variables.");
+    for (auto const& v: operands)
+      if (!Expr(v).must_be_binary())
+        throw std::logic_error("And/Or constraints require binary variables.");
+  }
+  p_impl = solver.p_impl->create_gen_constr(type, resultant, operands, name);
+}
+
+GenConstr::Type GenConstr::type() const
+{
+  return p_impl->m_type;
+}
+
+Var const& GenConstr::resultant() const
+{
+  return p_impl->m_resultant;
+}
+
+std::vector<Var> const& GenConstr::operands() const
+{
+  return p_impl->m_operands;
+}
+
+std::optional<std::string> const& GenConstr::name() const
+{
+  return p_impl->m_name;
+}
+
+std::ostream& operator<<(std::ostream& os, GenConstr const& c)
+{
+  static char const* const names[] = {"min", "max", "abs", "and", "or"};
+  os << c.resultant() << " = " << names[c.type()] << "(";
+  for (std::size_t i = 0; i < c.operands().size(); ++i)
+  {
+    if (i > 0)
+      os << ", ";
+    os << c.operands()[i];
+  }
+  os << ")";
+  return os;
+}
+
+double GenConstr::big_m() const
+{
+  auto const& xs = operands();
+  double const infinity = resultant().solver().infinity();
+
+  if (type() == And or type() == Or)
+    return 1;
+
+  double max_ub = -infinity;
+  double min_lb = infinity;
+  for (auto const& x: xs)
+  {
+    if (x.domain_lb() == -infinity or x.domain_ub() == infinity)
+      return infinity;
+    max_ub = std::max(max_ub, x.domain_ub());
+    min_lb = std::min(min_lb, x.domain_lb());
+  }
+
+  if (type() == Abs)
+  {
+    auto const& x = xs.front();
+    if (x.domain_lb() >= 0 or x.domain_ub() <= 0)
+      return 0;
+    double a = std::max(-x.domain_lb(), x.domain_ub());
+    return std::max(a - x.domain_lb(), a + x.domain_ub());
+  }
+
+  if (xs.size() == 1)
+    return 0;
+
+  double m = 0;
+  for (auto const& x: xs)
+    m = std::max(m, (type() == Max) ? max_ub - x.domain_lb() : x.domain_ub() - min_lb);
+  return m;
+}
+
+bool GenConstr::has_reformulation() const
+{
+  return big_m() != resultant().solver().infinity();
+}
+
+std::vector<Constr> GenConstr::reformulation() const
+{
+  if (!has_reformulation())
+    throw std::logic_error(
+      "Attempt to reformulate general constraint with unbounded operands."
+      " Try bounding the domain of the involved variables."
+    );
+
+  auto const& r = resultant();
+  auto const& xs = operands();
+  auto const& solver = r.solver();
+
+  std::vector<Constr> rs;
+
+  if (type() == And or type() == Or)
+  {
+    // And: r <= x_i /\ r >= sum(x_i) - (n - 1)
+    // Or:  r >= x_i /\ r <= sum(x_i)
+    Expr sum;
+    for (auto const& x: xs)
+    {
+      rs.push_back((type() == And) ? r <= x : x <= r);
+      sum += x;
+    }
+    if (type() == And)
+      rs.push_back(sum - (xs.size() - 1.0) <= r);
+    else
+      rs.push_back(r <= sum);
+    return rs;
+  }
+
+  if (type() == Abs)
+  {
+    auto const& x = xs.front();
+    if (x.domain_lb() >= 0)
+      rs.push_back(r == x);
+    else
+    if (x.domain_ub() <= 0)
+      rs.push_back(r == -x);
+    else
+    {
+      // r >= |x| /\ (b = 1 -> r <= x) /\ (b = 0 -> r <= -x)
+      double a = std::max(-x.domain_lb(), x.domain_ub());
+      Var b(solver, Var::Type::Binary);
+      rs.push_back(x <= r);
+      rs.push_back(-x <= r);
+      rs.push_back(r <= x + (a - x.domain_lb()) * (1 - b));
+      rs.push_back(r <= -x + (a + x.domain_ub()) * b);
+    }
+    return rs;
+  }
+
+  if (xs.size() == 1)
+  {
+    rs.push_back(r == xs.front());
+    return rs;
+  }
+
+  // Max: r >= x_i /\ (b_i = 1 -> r <= x_i) /\ sum(b_i) = 1
+  // Min: r <= x_i /\ (b_i = 1 -> r >= x_i) /\ sum(b_i) = 1
+  double max_ub = xs.front().domain_ub();
+  double min_lb = xs.front().domain_lb();
+  for (auto const& x: xs)
+  {
+    max_ub = std::max(max_ub, x.domain_ub());
+    min_lb = std::min(min_lb, x.domain_lb());
+  }
+
+  Expr bs_sum;
+  for (auto const& x: xs)
+  {
+    Var b(solver, Var::Type::Binary);
+    bs_sum += b;
+    if (type() == Max)
+    {
+      rs.push_back(x <= r);
+      rs.push_back(r <= x + (max_ub - x.domain_lb()) * (1 - b));
+    }
+    else
+    {
+      rs.push_back(r <= x);
+      rs.push_back(x - (x.domain_ub() - min_lb) * (1 - b) <= r);
+    }
+  }
+  rs.push_back(bs_sum == 1);
+  return rs;
+}
+
+/**
+ *  Piecewise linear constraints
+ **/
+
+PwlConstr::PwlConstr(
+  Solver const& solver,
+  Var const& x,
+  Var const& y,
+  std::vector<double> const& xs,
+  std::vector<double> const& ys,
+  std::optional<std::string> const& name
+)
+{
+  if (xs.size() != ys.size())
+    throw std::logic_error("Piecewise linear constraint must have as many x as y breakpoints.");
+  if (xs.size() < 2)
+    throw std::logic_error("Piecewise linear constraint must have at least two breakpoints.");
+  if (!std::is_sorted(xs.begin(), xs.end()))
+    throw std::logic_error("Piecewise linear constraint x breakpoints must be non-decreasing.");
+  p_impl = solver.p_impl->create_pwl_constr(x, y, xs, ys, name);
+}
+
+Var const& PwlConstr::x() const
+{
+  return p_impl->m_x;
+}
+
+Var const& PwlConstr::y() const
+{
+  return p_impl->m_y;
+}
+
+std::vector<double> const& PwlConstr::xs() const
+{
+  return p_impl->m_xs;
+}
+
+std::vector<double> const& PwlConstr::ys() const
+{
+  return p_impl->m_ys;
+}
+
+std::optional<std::string> const& PwlConstr::name() const
+{
+  return p_impl->m_name;
+}
+
+std::ostream& operator<<(std::ostream& os, PwlConstr const& c)
+{
+  os << c.y() << " = pwl(" << c.x();
+  for (std::size_t i = 0; i < c.xs().size(); ++i)
+    os << ", (" << c.xs()[i] << ", " << c.ys()[i] << ")";
+  os << ")";
+  return os;
+}
+
+// x = sum(l_i * xs_i) /\ y = sum(l_i * ys_i) /\ sum(l_i) = 1, l_i >= 0.
+static std::vector<Constr> convex_combination(
+  PwlConstr const& constr, std::vector<Var> const& ls
+)
+{
+  Expr x, y, sum;
+  for (std::size_t i = 0; i < ls.size(); ++i)
+  {
+    x += constr.xs()[i] * ls[i];
+    y += constr.ys()[i] * ls[i];
+    sum += ls[i];
+  }
+  return {constr.x() == x, constr.y() == y, sum == 1};
+}
+
+static std::vector<Var> convex_combination_vars(PwlConstr const& constr)
+{
+  std::vector<Var> ls;
+  for (std::size_t i = 0; i < constr.xs().size(); ++i)
+    ls.emplace_back(constr.x().solver(), Var::Type::Continuous, 0, 1);
+  return ls;
+}
+
+std::pair<std::vector<Constr>, SOSConstr> PwlConstr::sos2_reformulation() const
+{
+  auto ls = convex_combination_vars(*this);
+  return {
+    convex_combination(*this, ls),
+    SOSConstr(x().solver(), SOSConstr::SOS2, ls)
+  };
+}
+
+std::vector<Constr> PwlConstr::log_reformulation() const
+{
+  auto ls = convex_combination_vars(*this);
+  auto r = convex_combination(*this, ls);
+
+  // Segment s (between breakpoints s and s+1) is identified by the gray
+  // code of s over the binaries zs, so that consecutive segments differ
+  // in a single bit. For each bit, breakpoints only adjacent to segments
+  // having that bit set (resp. unset) are disabled when the bit is unset (resp. set).
+  std::size_t const nr_segments = ls.size() - 1;
+  std::size_t nr_bits = 0;
+  while ((std::size_t(1) << nr_bits) < nr_segments)
+    ++nr_bits;
+
+  auto gray = [](std::size_t s) { return s ^ (s >> 1); };
+
+  for (std::size_t b = 0; b < nr_bits; ++b)
+  {
+    Var z(x().solver(), Var::Type::Binary);
+    Expr ones, zeros;
+    for (std::size_t i = 0; i < ls.size(); ++i)
+    {
+      bool all_set = true;
+      bool all_unset = true;
+      for (std::size_t s: {i - 1, i})
+      {
+        // segments adjacent to breakpoint i
+        if (s >= nr_segments)
+          continue;
+        bool bit = (gray(s) >> b) & 1;
+        all_set = all_set and bit;
+        all_unset = all_unset and !bit;
+      }
+      if (all_set)
+        ones += ls[i];
+      if (all_unset)
+        zeros += ls[i];
+    }
+    if (!ones.is_constant())
+      r.push_back(ones <= z);
+    if (!zeros.is_constant())
+      r.push_back(zeros <= 1 - z);
+  }
+
+  return r;
+}
+
 }  // namespace miplib
@@ -14,6 +14,9 @@ static double constexpr MAX_MAX_ABS_SKIP_SCALE = 1e4;
 namespace detail {
 struct IConstr;
 struct IIndicatorConstr;
+struct ISOSConstr;
+struct IGenConstr;
+struct IPwlConstr;
 struct GurobiCurrentStateHandle;
 struct ScipCurrentStateHandle;
 }  // namespace detail
@@ -21,7 +24,8 @@ struct ScipCurrentStateHandle;
 // Linear or quadratic constraint.
 struct Constr
 {
-  enum Type { LessEqual, Equal };
+  // Range constraints stand for -width() <= expr() <= 0.
+  enum Type { LessEqual, Equal, Range };
 
   Constr(
     Solver const& solver,
@@ -30,8 +34,18 @@ struct Constr
     std::optional<std::string> const& name = std::nullopt
   );
 
+  // Range constraint -width <= e <= 0.
+  Constr(
+    Solver const& solver,
+    Expr const& e,
+    double width,
+    std::optional<std::string> const& name = std::nullopt
+  );
+
   Expr expr() const;
   Type type() const;
+  // zero unless type() is Range.
+  double width() const;
   std::optional<std::string> const& name() const;
 
   bool is_reifiable() const;
@@ -40,6 +54,13 @@ struct Constr
   bool must_be_satisfied() const;
   bool must_be_violated() const;
 
+  // if the set of solutions is convex, i.e. if the constraint is
+  // linear or of the form convex expr <= 0.
+  bool is_convex() const;
+
+  // see Solver::duals.
+  double dual() const;
+
   Constr scale(
     double skip_lb = MIN_MAX_ABS_SKIP_SCALE,
     double skip_ub = MAX_MAX_ABS_SKIP_SCALE,
@@ -47,8 +68,11 @@ struct Constr
   ) const;
   
   private:
+  explicit Constr(std::shared_ptr<detail::IConstr> const& p_impl): p_impl(p_impl) {}
+
   std::shared_ptr<detail::IConstr> p_impl;
   friend std::ostream& operator<<(std::ostream& os, Constr const& c);
+  friend struct Solver;
   friend struct GurobiSolver;
   friend struct ScipSolver;
   friend struct LpsolveSolver;
@@ -66,6 +90,18 @@ inline Constr operator>=(Expr const& e1, Expr const& e2)
   return e2 <= e1;
 }
 
+// Two-sided constraint lb <= e <= ub, posted as a single row.
+Constr range(double lb, Expr const& e, double ub);
+
+// Replaces the linear subexpressions (terms with the same coefficients)
+// shared by several constraints by auxiliary variables, each defined by
+// a single equality, when that reduces the number of nonzeros. Returns
+// the rewritten constraints, ordered as the input, followed by the
+// definitions: they are to be posted instead of constrs.
+std::vector<Constr> extract_common_subexpressions(
+  std::vector<Constr> const& constrs, std::size_t min_size = 3
+);
+
 // Indicator constraint.
 struct IndicatorConstr
 {
@@ -84,6 +120,10 @@ struct IndicatorConstr
   bool has_reformulation() const;
   std::vector<Constr> reformulation() const;
 
+  // largest big-M coefficient introduced by reformulation()
+  // (infinity if the implicand is not bounded).
+  double big_m() const;
+
   // implies has_reformulation.
   std::vector<Constr> scale(
     double skip_lb = MIN_MAX_ABS_SKIP_SCALE,
@@ -102,6 +142,12 @@ std::ostream& operator<<(std::ostream& os, Expr const& e);
 IndicatorConstr operator>>(Constr const& implicant, Constr const& implicand);
 IndicatorConstr operator<<(Constr const& implicand, Constr const& implicant);
 
+// Reformulation of a batch of indicator constraints, split over
+// nr_threads threads. The result is ordered as the input.
+std::vector<Constr> reformulation(
+  std::vector<IndicatorConstr> const& constrs, std::size_t nr_threads = 1
+);
+
 inline IndicatorConstr operator>>(Expr const& implicant, Constr const& implicand)
 {
   return (implicant == 1) >> implicand;
@@ -112,6 +158,118 @@ inline IndicatorConstr operator<<(Constr const& implicand, Expr const& implicant
   return (implicant == 1) >> implicand;
 }
 
+// Special ordered set constraint: at most one (SOS1) or two consecutive (SOS2)
+// variables can be nonzero, variables being ordered by increasing weight.
+struct SOSConstr
+{
+  enum Type { SOS1, SOS2 };
+
+  SOSConstr(
+    Solver const& solver,
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name = std::nullopt
+  );
+
+  // weights are 1, 2, ..., vars.size().
+  SOSConstr(
+    Solver const& solver,
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::optional<std::string> const& name = std::nullopt
+  );
+
+  Type type() const;
+  // sorted by increasing weight.
+  std::vector<Var> const& vars() const;
+  std::vector<double> const& weights() const;
+  std::optional<std::string> const& name() const;
+
+  // if all the variables have finite bounds.
+  bool has_reformulation() const;
+  // introduces one binary variable per variable (SOS1) or
+  // per pair of consecutive variables (SOS2).
+  std::vector<Constr> reformulation() const;
+
+  private:
+  std::shared_ptr<detail::ISOSConstr> p_impl;
+  friend std::ostream& operator<<(std::ostream& os, SOSConstr const& c);
+  friend struct GurobiSolver;
+  friend struct ScipSolver;
+  friend struct LpsolveSolver;
+};
+
+// General constraint resultant = f(operands), f being the minimum, maximum
+// or absolute value of continuous operands, or the conjunction or
+// disjunction of binary operands.
+struct GenConstr
+{
+  enum Type { Min, Max, Abs, And, Or };
+
+  // Abs takes exactly one operand.
+  GenConstr(
+    Solver const& solver,
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name = std::nullopt
+  );
+
+  Type type() const;
+  Var const& resultant() const;
+  std::vector<Var> const& operands() const;
+  std::optional<std::string> const& name() const;
+
+  bool has_reformulation() const;
+  // introduces binary variables for Min, Max and Abs.
+  std::vector<Constr> reformulation() const;
+
+  // largest big-M coefficient introduced by reformulation()
+  // (infinity if some operand is not bounded).
+  double big_m() const;
+
+  private:
+  std::shared_ptr<detail::IGenConstr> p_impl;
+  friend std::ostream& operator<<(std::ostream& os, GenConstr const& c);
+  friend struct GurobiSolver;
+  friend struct ScipSolver;
+};
+
+// Piecewise linear constraint y = f(x), f interpolating the breakpoints
+// (xs[i], ys[i]) with xs non-decreasing. x is restricted to [xs.front(), xs.back()].
+struct PwlConstr
+{
+  // Encoding of the reformulation for backends without native support.
+  enum class Encoding { SOS2, Logarithmic };
+
+  PwlConstr(
+    Solver const& solver,
+    Var const& x,
+    Var const& y,
+    std::vector<double> const& xs,
+    std::vector<double> const& ys,
+    std::optional<std::string> const& name = std::nullopt
+  );
+
+  Var const& x() const;
+  Var const& y() const;
+  std::vector<double> const& xs() const;
+  std::vector<double> const& ys() const;
+  std::optional<std::string> const& name() const;
+
+  // Convex combination of the breakpoints whose weights form an SOS2 set.
+  std::pair<std::vector<Constr>, SOSConstr> sos2_reformulation() const;
+  // Convex combination of the breakpoints with the segment selected by
+  // ceil(log2(#segments)) binaries (Vielma and Nemhauser).
+  std::vector<Constr> log_reformulation() const;
+
+  private:
+  std::shared_ptr<detail::IPwlConstr> p_impl;
+  friend std::ostream& operator<<(std::ostream& os, PwlConstr const& c);
+  friend struct GurobiSolver;
+};
+
 namespace detail {
 struct IConstr
 {
@@ -123,6 +281,7 @@ struct IConstr
   virtual ~IConstr() {}
   Expr m_expr;
   Constr::Type m_type;
+  double m_width = 0;
   std::optional<std::string> m_name;
 };
 
@@ -139,12 +298,80 @@ struct IIndicatorConstr
   Constr m_implicand;
   std::optional<std::string> m_name;
 };
+struct ISOSConstr
+{
+  ISOSConstr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name):
+    m_type(type),
+    m_vars(vars), m_weights(weights), m_name(name)
+  {}
+  virtual ~ISOSConstr() {}
+  SOSConstr::Type m_type;
+  std::vector<Var> m_vars;
+  std::vector<double> m_weights;
+  std::optional<std::string> m_name;
+};
+
+struct IGenConstr
+{
+  IGenConstr(
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name):
+    m_type(type),
+    m_resultant(resultant), m_operands(operands), m_name(name)
+  {}
+  virtual ~IGenConstr() {}
+  GenConstr::Type m_type;
+  Var m_resultant;
+  std::vector<Var> m_operands;
+  std::optional<std::string> m_name;
+};
+
+struct IPwlConstr
+{
+  IPwlConstr(
+    Var const& x,
+    Var const& y,
+    std::vector<double> const& xs,
+    std::vector<double> const& ys,
+    std::optional<std::string> const& name):
+    m_x(x), m_y(y),
+    m_xs(xs), m_ys(ys), m_name(name)
+  {}
+  virtual ~IPwlConstr() {}
+  Var m_x;
+  Var m_y;
+  std::vector<double> m_xs;
+  std::vector<double> m_ys;
+  std::optional<std::string> m_name;
+};
+
 std::shared_ptr<detail::IIndicatorConstr> create_reformulatable_indicator_constr(
   Constr const& implicant,
   Constr const& implicand,
   std::optional<std::string> const& name
 );
 
+std::shared_ptr<detail::IGenConstr> create_reformulatable_gen_constr(
+  GenConstr::Type const& type,
+  Var const& resultant,
+  std::vector<Var> const& operands,
+  std::optional<std::string> const& name
+);
+
+std::shared_ptr<detail::IPwlConstr> create_reformulatable_pwl_constr(
+  Var const& x,
+  Var const& y,
+  std::vector<double> const& xs,
+  std::vector<double> const& ys,
+  std::optional<std::string> const& name
+);
+
 }  // namespace detail
 
 }  // namespace miplib
@@ -1,6 +1,7 @@
 
 #include "expr.hpp"
 #include "solver.hpp"
+#include <miplib/util/convexity.hpp>
 
 #include <set>
 #include <fmt/ostream.h>
@@ -408,32 +409,33 @@ static bool is_integer(double c) {
 
 bool Expr::must_be_integer() const
 {
+  auto const is_integer_var = [](Var const& v) {
+    auto const type = v.type();
+    return
+      type == Var::Type::Binary or
+      type == Var::Type::Integer or
+      type == Var::Type::SemiInteger;
+  };
+
   if (!is_integer(constant()))
     return false;
 
-  for (auto const& coeff: linear_coeffs())
-    if (!is_integer(coeff))
-      return false;
-
-  for (auto const& var: linear_vars())
-    if (var.type() != Var::Type::Binary and var.type() != Var::Type::Integer)
-      return false;
-
-  for (auto const& coeff: quad_coeffs())
-    if (!is_integer(coeff))
-      return false;
-
-  for (auto const& var: quad_vars_1())
-    if (var.type() != Var::Type::Binary and var.type() != Var::Type::Integer)
+  for (auto const& [v, c]: p_impl->m_linear)
+    if (!is_integer(c) or !is_integer_var(v))
       return false;
 
-  for (auto const& var: quad_vars_2())
-    if (var.type() != Var::Type::Binary and var.type() != Var::Type::Integer)
+  for (auto const& [v1v2, c]: p_impl->m_quad)
+    if (!is_integer(c) or !is_integer_var(v1v2.first) or !is_integer_var(v1v2.second))
       return false;
 
   return true;
 }
 
+bool Expr::is_convex() const
+{
+  return is_linear() or detail::is_positive_semidefinite(*this);
+}
+
 double Expr::is_zero() const
 {
   return is_constant() and constant() == 0;
@@ -508,8 +510,8 @@ std::vector<Var> Expr::quad_vars_2() const
 // Returns the lower and upper bounds of a term.
 static std::pair<double, double> linear_term_bounds(Var const& v, double coeff, bool ignore_inf_var_bounds)
 {
-  auto var_lb = v.lb();
-  auto var_ub = v.ub();
+  auto var_lb = v.domain_lb();
+  auto var_ub = v.domain_ub();
 
   double const inf = v.solver().infinity();
   if (ignore_inf_var_bounds)
@@ -530,31 +532,6 @@ static std::pair<double, double> linear_term_bounds(Var const& v, double coeff,
 }
 
 
-// Returns the lower and upper bounds of a linear expression.
-std::pair<double, double> Expr::bounds() const
-{
-  if (!is_linear()) 
-    throw std::logic_error(
-      fmt::format("Querying bounds of a nonlinear expression is not implemented yet: {}.", *this)
-    );
-
-  auto const lin_coeffs = linear_coeffs();
-  auto const lin_vars = linear_vars();
-
-  double lb = constant();
-  double ub = constant();
-
-  double const inf = solver().infinity();
-
-  for (std::size_t i = 0; i < lin_coeffs.size(); ++i)
-  {
-    auto const [term_lb, term_ub] = linear_term_bounds(lin_vars[i], lin_coeffs[i], false);
-    lb += term_lb;
-    ub += term_ub;
-  }
-  return std::make_pair(std::max(-inf, lb), std::min(inf, ub));
-}
-
 // Returns the maximum absolute value of the term with lowest maximum absolute value and
 // the maximum absolute value of the term with highest maximum absolute value.
 std::pair<double, double> Expr::numerical_range(bool ignore_inf_var_bounds) const
@@ -683,64 +660,83 @@ static double interval_prod_ub(
 }
 
 
-double Expr::lb() const
+// Computes the lower and upper bounds of an expression using interval
+// arithmetic in a single pass over its terms (i.e. without copying or
+// negating it). A bound is infinite if any of the terms is unbounded
+// in that direction.
+static std::pair<double, double> interval_bounds(detail::ExprImpl const& e, double infinity)
 {
-  double infinity = solver().infinity();
-
-  double r = constant();
+  double lb = e.m_constant;
+  double ub = e.m_constant;
+  bool lb_is_inf = false;
+  bool ub_is_inf = false;
 
   // linear part
-  auto const lv = linear_vars();
-  auto const lc = linear_coeffs();
-  for (std::size_t i = 0; i < lc.size(); ++i)
-    if (lc[i] > 0)
+  for (auto const& [v, c]: e.m_linear)
+  {
+    double const v_lb = v.domain_lb();
+    double const v_ub = v.domain_ub();
+    if (c > 0)
     {
-      if (lv[i].lb() == -infinity)
-        return -infinity;
-      else
-        r += lc[i] * lv[i].lb();
+      lb_is_inf |= (v_lb == -infinity);
+      ub_is_inf |= (v_ub == infinity);
+      lb += c * v_lb;
+      ub += c * v_ub;
     }
     else
-    if (lc[i] < 0)
+    if (c < 0)
     {
-      if (lv[i].ub() == infinity)
-        return -infinity;
-      else
-        r += lc[i] * lv[i].ub();
+      lb_is_inf |= (v_ub == infinity);
+      ub_is_inf |= (v_lb == -infinity);
+      lb += c * v_ub;
+      ub += c * v_lb;
     }
+  }
 
   // quadratic part
-  auto const qv1 = quad_vars_1();
-  auto const qv2 = quad_vars_2();
-  auto const qc = quad_coeffs();
-  for (std::size_t i = 0; i < qc.size(); ++i)
-    if (qc[i] > 0)
+  for (auto const& [v1v2, c]: e.m_quad)
+  {
+    auto const& [v1, v2] = v1v2;
+    double const lb1 = v1.domain_lb();
+    double const ub1 = v1.domain_ub();
+    double const lb2 = v2.domain_lb();
+    double const ub2 = v2.domain_ub();
+    double const prod_lb = interval_prod_lb(lb1, ub1, lb2, ub2, v1.is_same(v2));
+    double const prod_ub = interval_prod_ub(lb1, ub1, lb2, ub2);
+    if (c > 0)
     {
-      double lb = interval_prod_lb(
-        qv1[i].lb(), qv1[i].ub(), qv2[i].lb(), qv2[i].ub(),
-        qv1[i].is_same(qv2[i])
-      );      
-      if (lb <= -infinity)
-        return -infinity;
-      r += qc[i] * lb;
+      lb_is_inf |= (prod_lb <= -infinity);
+      ub_is_inf |= (prod_ub >= infinity);
+      lb += c * prod_lb;
+      ub += c * prod_ub;
     }
     else
-    if (qc[i] < 0)
+    if (c < 0)
     {
-      double ub = interval_prod_ub(
-        qv1[i].lb(), qv1[i].ub(), qv2[i].lb(), qv2[i].ub()
-      );      
-      if (ub >= infinity)
-        return -infinity;
-      r += qc[i] * ub;
+      lb_is_inf |= (prod_ub >= infinity);
+      ub_is_inf |= (prod_lb <= -infinity);
+      lb += c * prod_ub;
+      ub += c * prod_lb;
     }
+  }
 
-  return r;
+  return std::make_pair(lb_is_inf ? -infinity : lb, ub_is_inf ? infinity : ub);
+}
+
+// Returns the lower and upper bounds of the expression.
+std::pair<double, double> Expr::bounds() const
+{
+  return interval_bounds(*p_impl, solver().infinity());
+}
+
+double Expr::lb() const
+{
+  return bounds().first;
 }
 
 double Expr::ub() const
 {
-  return -(-(*this)).lb();
+  return bounds().second;
 }
 
 double Expr::value() const
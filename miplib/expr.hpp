@@ -66,6 +66,9 @@ struct Expr
   bool must_be_binary() const;
   bool must_be_integer() const;
 
+  // if the quadratic part is positive semidefinite.
+  bool is_convex() const;
+
   // constant term
   double constant() const
   {
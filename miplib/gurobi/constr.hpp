@@ -33,4 +33,41 @@ struct GurobiIndicatorConstr : detail::IIndicatorConstr
   mutable std::optional<GRBGenConstr> m_constr;
 };
 
+struct GurobiSOSConstr : detail::ISOSConstr
+{
+  GurobiSOSConstr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name
+  ): detail::ISOSConstr(type, vars, weights, name)
+  {}
+  mutable std::optional<GRBSOS> m_constr;
+};
+
+struct GurobiGenConstr : detail::IGenConstr
+{
+  GurobiGenConstr(
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name
+  ): detail::IGenConstr(type, resultant, operands, name)
+  {}
+  mutable std::optional<GRBGenConstr> m_constr;
+};
+
+struct GurobiPwlConstr : detail::IPwlConstr
+{
+  GurobiPwlConstr(
+    Var const& x,
+    Var const& y,
+    std::vector<double> const& xs,
+    std::vector<double> const& ys,
+    std::optional<std::string> const& name
+  ): detail::IPwlConstr(x, y, xs, ys, name)
+  {}
+  mutable std::optional<GRBGenConstr> m_constr;
+};
+
 }  // namespace miplib
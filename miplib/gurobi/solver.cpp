@@ -12,6 +12,8 @@
 #include <fmt/ostream.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace miplib {
 
 static GRBEnv init_env(bool verbose) {
@@ -27,6 +29,14 @@ GurobiSolver::GurobiSolver(bool verbose) :
   pending_update(false)
   {}
 
+// Gurobi environments are not shared by threads, hence the copy.
+GurobiSolver::GurobiSolver(GRBModel const& source) :
+  env(init_env(source.get(GRB_IntParam_OutputFlag))),
+  model(source, env),
+  pending_update(false),
+  model_has_changed_since_last_solve(true)
+  {}
+
 void GurobiSolver::set_pending_update() const
 {
   pending_update = true;
@@ -47,6 +57,20 @@ std::shared_ptr<detail::IVar> GurobiSolver::create_var(
   std::optional<double> const& ub,
   std::optional<std::string> const& name
 )
+{
+  return create_column(solver, type, lb, ub, 0, {}, {}, name);
+}
+
+std::shared_ptr<detail::IVar> GurobiSolver::create_column(
+  Solver const& solver,
+  Var::Type const& type,
+  std::optional<double> const& lb,
+  std::optional<double> const& ub,
+  double obj,
+  std::vector<Constr> const& constrs,
+  std::vector<double> const& coeffs,
+  std::optional<std::string> const& name
+)
 {
   char grb_var_type;
   double grb_lb, grb_ub;
@@ -73,13 +97,32 @@ std::shared_ptr<detail::IVar> GurobiSolver::create_var(
     grb_lb = lb.value_or(-GRB_INFINITY);
     grb_ub = ub.value_or(GRB_INFINITY);
   }
+  else if (type == Var::Type::SemiContinuous or type == Var::Type::SemiInteger)
+  {
+    grb_var_type = (type == Var::Type::SemiContinuous) ? GRB_SEMICONT : GRB_SEMIINT;
+    grb_lb = lb.value_or(0);
+    grb_ub = ub.value_or(GRB_INFINITY);
+  }
   else
   {
     throw std::logic_error("Gurobi does not support this variable type");
   }
 
-  GRBVar grb_var = model.addVar(grb_lb, grb_ub, 0.0, grb_var_type, name.value_or(""));
-  return std::make_shared<GurobiVar>(solver, grb_var);
+  GRBColumn grb_column;
+  for (std::size_t i = 0; i < constrs.size(); ++i)
+  {
+    auto const& c = static_cast<GurobiLinConstr const&>(*constrs[i].p_impl);
+    if (!c.m_constr.has_value())
+      throw std::logic_error("Attempt to add a column to a constraint that was not posted.");
+    grb_column.addTerm(coeffs[i], c.m_constr.value());
+  }
+
+  GRBVar grb_var = model.addVar(
+    grb_lb, grb_ub, obj, grb_var_type, grb_column, name.value_or("")
+  );
+  auto p_var = std::make_shared<GurobiVar>(solver, grb_var);
+  m_objective_coeffs.record(p_var, obj);
+  return p_var;
 }
 
 static GRBLinExpr as_grb_lin_expr(Expr const& e)
@@ -174,21 +217,64 @@ std::shared_ptr<detail::IIndicatorConstr> GurobiSolver::create_indicator_constr(
   return std::make_shared<GurobiIndicatorConstr>(implicant, implicand, name);
 }
 
+std::shared_ptr<detail::ISOSConstr> GurobiSolver::create_sos_constr(
+  SOSConstr::Type const& type,
+  std::vector<Var> const& vars,
+  std::vector<double> const& weights,
+  std::optional<std::string> const& name)
+{
+  return std::make_shared<GurobiSOSConstr>(type, vars, weights, name);
+}
+
+std::shared_ptr<detail::IGenConstr> GurobiSolver::create_gen_constr(
+  GenConstr::Type const& type,
+  Var const& resultant,
+  std::vector<Var> const& operands,
+  std::optional<std::string> const& name)
+{
+  return std::make_shared<GurobiGenConstr>(type, resultant, operands, name);
+}
+
+std::shared_ptr<detail::IPwlConstr> GurobiSolver::create_pwl_constr(
+  Var const& x,
+  Var const& y,
+  std::vector<double> const& xs,
+  std::vector<double> const& ys,
+  std::optional<std::string> const& name)
+{
+  return std::make_shared<GurobiPwlConstr>(x, y, xs, ys, name);
+}
+
 void GurobiSolver::set_objective(Solver::Sense const& sense, Expr const& e)
 {
   int grb_sense = sense == Solver::Sense::Minimize ? GRB_MINIMIZE : GRB_MAXIMIZE;
+  // only the coefficients that changed are posted, if known.
+  std::optional<std::vector<std::pair<std::shared_ptr<detail::IVar>, double>>> changes;
+  if (e.is_linear() and !m_objective_is_quadratic)
+    changes = m_objective_coeffs.update(e);
+
+  if (changes.has_value())
+  {
+    for (auto const& [p_var, coeff]: changes.value())
+      static_cast<GurobiVar&>(*p_var).m_var.set(GRB_DoubleAttr_Obj, coeff);
+    model.set(GRB_DoubleAttr_ObjCon, e.constant());
+    model.set(GRB_IntAttr_ModelSense, grb_sense);
+  }
+  else
   if (e.is_linear())
   {
     GRBLinExpr grb_expr = as_grb_lin_expr(e);
     model.setObjective(grb_expr, grb_sense);
-    model_has_changed_since_last_solve = true;
+    m_objective_coeffs.reset(e);
   }
   else
   if (e.is_quadratic()) {
     GRBQuadExpr grb_expr = as_grb_quad_expr(e);    
     model.setObjective(grb_expr, grb_sense);
-    model_has_changed_since_last_solve = true;
+    m_objective_coeffs.reset(e);
   }
+  m_objective_is_quadratic = !e.is_linear();
+  model_has_changed_since_last_solve = true;
 }
 
 double GurobiSolver::get_objective_value() const
@@ -220,7 +306,18 @@ void GurobiSolver::add(Constr const& constr)
     return;
   }
 
-  if (e.is_linear())
+  if (e.is_linear() and type == Constr::Range)
+  {
+    GRBLinExpr range_expr = as_grb_lin_expr(e - e.constant());
+
+    static_cast<GurobiLinConstr const&>(*constr.p_impl).m_constr
+      = model.addRange(
+        range_expr, -constr.width() - e.constant(), -e.constant(), name.value_or("")
+      );
+
+    model_has_changed_since_last_solve = true;
+  }
+  else if (e.is_linear())
   {
     GRBLinExpr lhs_expr = as_grb_lin_expr(e);
 
@@ -231,6 +328,10 @@ void GurobiSolver::add(Constr const& constr)
     
     model_has_changed_since_last_solve = true;
   }
+  else if (type == Constr::Range)
+  {
+    throw std::logic_error("Gurobi does not support quadratic range constraints.");
+  }
   else if (e.is_quadratic())
   {
     GRBQuadExpr lhs_expr = as_grb_quad_expr(e);
@@ -277,6 +378,10 @@ bool GurobiSolver::supports_indicator_constraint(IndicatorConstr const& constr)
   if (!implicand.expr().is_linear())
     return false;
 
+  // Gurobi indicator constraints cannot express a two-sided implicand.
+  if (implicand.type() == Constr::Range)
+    return false;
+
   return true;
 }
 
@@ -322,6 +427,123 @@ void GurobiSolver::add(IndicatorConstr const& constr)
   model_has_changed_since_last_solve = true;
 }
 
+bool GurobiSolver::supports_sos_constraint(SOSConstr const&) const
+{
+  // Gurobi does not support adding SOS constraints during solving.
+  return !is_in_callback();
+}
+
+void GurobiSolver::add(SOSConstr const& constr)
+{
+  if (is_in_callback())
+    throw std::logic_error(
+      "Gurobi doesn't support adding SOS constraints during solving. Try ctr.reformulation()."
+    );
+
+  std::vector<GRBVar> grb_vars;
+  std::transform(
+    constr.vars().begin(),
+    constr.vars().end(),
+    std::back_inserter(grb_vars),
+    [](auto const& v) { return static_cast<GurobiVar const&>(*v.p_impl).m_var; }
+  );
+
+  static_cast<GurobiSOSConstr const&>(*constr.p_impl).m_constr = model.addSOS(
+    grb_vars.data(),
+    constr.weights().data(),
+    grb_vars.size(),
+    (constr.type() == SOSConstr::SOS1) ? GRB_SOS_TYPE1 : GRB_SOS_TYPE2
+  );
+
+  model_has_changed_since_last_solve = true;
+}
+
+bool GurobiSolver::supports_gen_constraint(GenConstr const&) const
+{
+  // Gurobi does not support adding general constraints during solving.
+  return !is_in_callback();
+}
+
+void GurobiSolver::add(GenConstr const& constr)
+{
+  if (is_in_callback())
+    throw std::logic_error(
+      "Gurobi doesn't support adding general constraints during solving. Try ctr.reformulation()."
+    );
+
+  auto as_grb_var = [](Var const& v) {
+    return static_cast<GurobiVar const&>(*v.p_impl).m_var;
+  };
+
+  GRBVar resultant = as_grb_var(constr.resultant());
+  std::vector<GRBVar> operands;
+  std::transform(
+    constr.operands().begin(),
+    constr.operands().end(),
+    std::back_inserter(operands),
+    as_grb_var
+  );
+  std::string name = constr.name().value_or("");
+
+  auto& grb_constr = static_cast<GurobiGenConstr const&>(*constr.p_impl).m_constr;
+  switch (constr.type())
+  {
+    case GenConstr::Min:
+      grb_constr = model.addGenConstrMin(
+        resultant, operands.data(), operands.size(), GRB_INFINITY, name
+      );
+      break;
+    case GenConstr::Max:
+      grb_constr = model.addGenConstrMax(
+        resultant, operands.data(), operands.size(), -GRB_INFINITY, name
+      );
+      break;
+    case GenConstr::Abs:
+      grb_constr = model.addGenConstrAbs(resultant, operands.front(), name);
+      break;
+    case GenConstr::And:
+      grb_constr = model.addGenConstrAnd(resultant, operands.data(), operands.size(), name);
+      break;
+    case GenConstr::Or:
+      grb_constr = model.addGenConstrOr(resultant, operands.data(), operands.size(), name);
+      break;
+  }
+
+  model_has_changed_since_last_solve = true;
+}
+
+bool GurobiSolver::supports_pwl_constraint(PwlConstr const&) const
+{
+  // Gurobi does not support adding general constraints during solving.
+  return !is_in_callback();
+}
+
+void GurobiSolver::add(PwlConstr const& constr)
+{
+  if (is_in_callback())
+    throw std::logic_error(
+      "Gurobi doesn't support adding piecewise linear constraints during solving."
+    );
+
+  GRBVar x = static_cast<GurobiVar const&>(*constr.x().p_impl).m_var;
+  GRBVar y = static_cast<GurobiVar const&>(*constr.y().p_impl).m_var;
+  auto const& xs = constr.xs();
+  auto const& ys = constr.ys();
+
+  static_cast<GurobiPwlConstr const&>(*constr.p_impl).m_constr = model.addGenConstrPWL(
+    x, y, xs.size(), xs.data(), ys.data(), constr.name().value_or("")
+  );
+
+  // Gurobi extrapolates f outside of the breakpoints, which the
+  // reformulations used by the other backends do not allow.
+  if (constr.x().lb() < xs.front())
+    model.addConstr(x, GRB_GREATER_EQUAL, xs.front());
+  if (constr.x().ub() > xs.back())
+    model.addConstr(x, GRB_LESS_EQUAL, xs.back());
+
+  model_has_changed_since_last_solve = true;
+}
+
 void GurobiSolver::remove(Constr const& constr)
 {
   if (std::dynamic_pointer_cast<GurobiLinConstr>(constr.p_impl))
@@ -341,6 +563,110 @@ void GurobiSolver::remove(Constr const& constr)
     assert(false);
 }
 
+void GurobiSolver::set_coeff(Constr const& constr, Var const& var, double coeff)
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+
+  auto p_lin_constr = std::dynamic_pointer_cast<GurobiLinConstr>(constr.p_impl);
+  if (!p_lin_constr)
+    throw std::logic_error("Gurobi does not support changing coefficients of quadratic constraints.");
+  if (!p_lin_constr->m_constr.has_value())
+    throw std::logic_error("Attempt to modify a constraint that was not posted.");
+
+  auto const& grb_var = static_cast<GurobiVar const&>(*var.p_impl).m_var;
+  model.chgCoeff(p_lin_constr->m_constr.value(), grb_var, coeff);
+  model_has_changed_since_last_solve = true;
+}
+
+void GurobiSolver::set_rhs(Constr const& constr, double rhs)
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+
+  if (auto p_lin_constr = std::dynamic_pointer_cast<GurobiLinConstr>(constr.p_impl))
+  {
+    if (!p_lin_constr->m_constr.has_value())
+      throw std::logic_error("Attempt to modify a constraint that was not posted.");
+    // Gurobi stores lb <= expr <= ub as expr - r = lb with 0 <= r <= ub - lb.
+    double const grb_rhs = constr.type() == Constr::Range ? rhs - constr.width() : rhs;
+    p_lin_constr->m_constr.value().set(GRB_DoubleAttr_RHS, grb_rhs);
+  }
+  else
+  {
+    auto const& c = static_cast<GurobiQuadConstr const&>(*constr.p_impl);
+    if (!c.m_constr.has_value())
+      throw std::logic_error("Attempt to modify a constraint that was not posted.");
+    c.m_constr.value().set(GRB_DoubleAttr_QCRHS, rhs);
+  }
+  model_has_changed_since_last_solve = true;
+}
+
+std::vector<double> GurobiSolver::get_duals(std::vector<Constr> const& constrs) const
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+  update_if_pending();
+
+  // linear and quadratic constraints are queried in a batch each.
+  std::vector<GRBConstr> lin_constrs;
+  std::vector<GRBQConstr> quad_constrs;
+  for (auto const& constr: constrs)
+  {
+    if (auto p_lin_constr = std::dynamic_pointer_cast<GurobiLinConstr>(constr.p_impl))
+    {
+      if (!p_lin_constr->m_constr.has_value())
+        throw std::logic_error("Attempt to query a constraint that was not posted.");
+      lin_constrs.push_back(p_lin_constr->m_constr.value());
+    }
+    else
+    {
+      auto const& c = static_cast<GurobiQuadConstr const&>(*constr.p_impl);
+      if (!c.m_constr.has_value())
+        throw std::logic_error("Attempt to query a constraint that was not posted.");
+      quad_constrs.push_back(c.m_constr.value());
+    }
+  }
+
+  // Gurobi allocates the arrays, the caller owns them.
+  std::unique_ptr<double[]> lin_duals, quad_duals;
+  call_with_exception_logging([&]{
+    if (!lin_constrs.empty())
+      lin_duals.reset(model.get(GRB_DoubleAttr_Pi, lin_constrs.data(), lin_constrs.size()));
+    if (!quad_constrs.empty())
+      quad_duals.reset(model.get(GRB_DoubleAttr_QCPi, quad_constrs.data(), quad_constrs.size()));
+  });
+
+  std::vector<double> r;
+  std::size_t lin_idx = 0, quad_idx = 0;
+  for (auto const& constr: constrs)
+  {
+    if (std::dynamic_pointer_cast<GurobiLinConstr>(constr.p_impl))
+      r.push_back(lin_duals[lin_idx++]);
+    else
+      r.push_back(quad_duals[quad_idx++]);
+  }
+  return r;
+}
+
+std::vector<double> GurobiSolver::get_reduced_costs(std::vector<Var> const& vars) const
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+  update_if_pending();
+
+  std::vector<GRBVar> grb_vars;
+  for (auto const& v: vars)
+    grb_vars.push_back(static_cast<GurobiVar const&>(*v.p_impl).m_var);
+
+  std::unique_ptr<double[]> reduced_costs;
+  call_with_exception_logging([&]{
+    if (!grb_vars.empty())
+      reduced_costs.reset(model.get(GRB_DoubleAttr_RC, grb_vars.data(), grb_vars.size()));
+  });
+  return std::vector<double>(reduced_costs.get(), reduced_costs.get() + grb_vars.size());
+}
+
 void GurobiSolver::set_non_convex_policy(Solver::NonConvexPolicy policy)
 {
   switch (policy)
@@ -354,6 +680,14 @@ void GurobiSolver::set_non_convex_policy(Solver::NonConvexPolicy policy)
     case Solver::NonConvexPolicy::Branch:
       model.set(GRB_IntParam_NonConvex, 2);
       break;
+    case Solver::NonConvexPolicy::McCormick:
+      // products are relaxed before reaching the model.
+      model.set(GRB_IntParam_NonConvex, 0);
+      break;
+    case Solver::NonConvexPolicy::Auto:
+      // raised to Branch once a nonconvex expression is posted.
+      model.set(GRB_IntParam_NonConvex, 0);
+      break;
     default:
       assert(false);
   }
@@ -451,6 +785,80 @@ std::pair<Solver::Result, bool> GurobiSolver::solve()
   return grb_status_to_solver_result(grb_status, has_solution);
 }
 
+void GurobiSolver::relax_integrality(bool fix_integers)
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+  update_if_pending();
+
+  // values are read before the model changes discard them.
+  int const nr_vars = model.get(GRB_IntAttr_NumVars);
+  std::unique_ptr<GRBVar[]> vars(model.getVars());
+  std::unique_ptr<double[]> values;
+  if (fix_integers)
+  {
+    if (model.get(GRB_IntAttr_SolCount) == 0)
+      throw std::logic_error("Attempt to fix integers without a solution.");
+    values.reset(call_with_exception_logging([&]{
+      return model.get(GRB_DoubleAttr_X, vars.get(), nr_vars);
+    }));
+  }
+
+  restore_integrality();
+  for (int i = 0; i < nr_vars; ++i)
+  {
+    auto& v = vars[i];
+    char const type = v.get(GRB_CharAttr_VType);
+    if (type == GRB_CONTINUOUS)
+      continue;
+    double const lb = v.get(GRB_DoubleAttr_LB);
+    double const ub = v.get(GRB_DoubleAttr_UB);
+    m_relaxed_vars.push_back({v, type, lb, ub});
+
+    auto const [new_lb, new_ub] = detail::relaxed_bounds(
+      type != GRB_SEMICONT,
+      type == GRB_SEMICONT or type == GRB_SEMIINT,
+      lb, ub,
+      fix_integers ? std::optional<double>(values[i]) : std::nullopt,
+      get_feasibility_tolerance()
+    );
+    v.set(GRB_CharAttr_VType, GRB_CONTINUOUS);
+    v.set(GRB_DoubleAttr_LB, new_lb);
+    v.set(GRB_DoubleAttr_UB, new_ub);
+  }
+  model_has_changed_since_last_solve = true;
+}
+
+void GurobiSolver::restore_integrality()
+{
+  if (m_relaxed_vars.empty())
+    return;
+  for (auto& relaxed_var: m_relaxed_vars)
+  {
+    relaxed_var.var.set(GRB_CharAttr_VType, relaxed_var.type);
+    relaxed_var.var.set(GRB_DoubleAttr_LB, relaxed_var.lb);
+    relaxed_var.var.set(GRB_DoubleAttr_UB, relaxed_var.ub);
+  }
+  m_relaxed_vars.clear();
+  model_has_changed_since_last_solve = true;
+}
+
+std::optional<detail::ISolver::DeclaredDomain> GurobiSolver::declared_domain(
+  detail::IVar const& var
+) const
+{
+  if (m_relaxed_vars.empty())
+    return std::nullopt;
+  int const idx = static_cast<GurobiVar const&>(var).m_var.index();
+  auto it = std::lower_bound(
+    m_relaxed_vars.begin(), m_relaxed_vars.end(), idx,
+    [](auto const& relaxed_var, int idx) { return relaxed_var.var.index() < idx; }
+  );
+  if (it == m_relaxed_vars.end() or it->var.index() != idx)
+    return std::nullopt;
+  return DeclaredDomain{gurobi_var_type(it->type), it->lb, it->ub};
+}
+
 double GurobiSolver::infinity() const
 {
   return GRB_INFINITY;
@@ -466,6 +874,11 @@ void GurobiSolver::set_time_limit(double secs)
   model.set(GRB_DoubleParam_TimeLimit, secs);
 }
 
+void GurobiSolver::interrupt()
+{
+  model.terminate();
+}
+
 bool GurobiSolver::is_in_callback() const
 {
   return p_callback and p_callback->is_active();
@@ -483,6 +896,84 @@ void GurobiSolver::set_warm_start(PartialSolution const& partial_solution)
   }
 }
 
+// Gurobi has a basis only for continuous models solved to optimality by
+// simplex, and leaves constraints at a bound unspecified.
+std::optional<Solver::Basis> GurobiSolver::get_basis() const
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+  update_if_pending();
+  if (model.get(GRB_IntAttr_IsMIP) or model.get(GRB_IntAttr_Status) != GRB_OPTIMAL)
+    return std::nullopt;
+
+  int const nr_vars = model.get(GRB_IntAttr_NumVars);
+  int const nr_constrs = model.get(GRB_IntAttr_NumConstrs);
+  std::unique_ptr<GRBVar[]> vars(model.getVars());
+  std::unique_ptr<GRBConstr[]> constrs(model.getConstrs());
+  std::unique_ptr<int[]> var_basis, constr_basis;
+  try
+  {
+    var_basis.reset(model.get(GRB_IntAttr_VBasis, vars.get(), nr_vars));
+    constr_basis.reset(model.get(GRB_IntAttr_CBasis, constrs.get(), nr_constrs));
+  }
+  catch (GRBException const&)
+  {
+    // e.g. solved by barrier without crossover.
+    return std::nullopt;
+  }
+
+  auto const to_status = [](int grb_status) {
+    switch (grb_status)
+    {
+      case 0: return Solver::BasisStatus::Basic;
+      case -1: return Solver::BasisStatus::AtLower;
+      case -2: return Solver::BasisStatus::AtUpper;
+      default: return Solver::BasisStatus::Superbasic;
+    }
+  };
+  Solver::Basis r;
+  std::transform(var_basis.get(), var_basis.get() + nr_vars, std::back_inserter(r.vars), to_status);
+  std::transform(
+    constr_basis.get(), constr_basis.get() + nr_constrs, std::back_inserter(r.constrs), to_status
+  );
+  return r;
+}
+
+bool GurobiSolver::set_basis(Solver::Basis const& basis)
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+  update_if_pending();
+
+  int const nr_vars = model.get(GRB_IntAttr_NumVars);
+  int const nr_constrs = model.get(GRB_IntAttr_NumConstrs);
+  if (basis.vars.size() != std::size_t(nr_vars) or basis.constrs.size() != std::size_t(nr_constrs))
+    return false;
+
+  auto const to_grb_status = [](Solver::BasisStatus status) {
+    switch (status)
+    {
+      case Solver::BasisStatus::Basic: return 0;
+      case Solver::BasisStatus::AtLower: return -1;
+      case Solver::BasisStatus::AtUpper: return -2;
+      default: return -3;
+    }
+  };
+  std::vector<int> var_basis, constr_basis;
+  std::transform(basis.vars.begin(), basis.vars.end(), std::back_inserter(var_basis), to_grb_status);
+  // nonbasic constraints are at their (single) bound.
+  for (auto const& status: basis.constrs)
+    constr_basis.push_back(status == Solver::BasisStatus::Basic ? 0 : -1);
+
+  std::unique_ptr<GRBVar[]> vars(model.getVars());
+  std::unique_ptr<GRBConstr[]> constrs(model.getConstrs());
+  call_with_exception_logging([&]{
+    model.set(GRB_IntAttr_VBasis, vars.get(), var_basis.data(), nr_vars);
+    model.set(GRB_IntAttr_CBasis, constrs.get(), constr_basis.data(), nr_constrs);
+  });
+  return true;
+}
+
 void GurobiSolver::set_reoptimizing(bool)
 {
   // GurobiSolver does not require explicitely enabling/disabling reoptimization.
@@ -493,6 +984,72 @@ void GurobiSolver::setup_reoptimization()
   // Gurobi does not require doing anything explicit before reoptimizing.
 }
 
+std::shared_ptr<detail::ISolver> GurobiSolver::clone() const
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+  update_if_pending();
+
+  auto p_clone = std::make_shared<GurobiSolver>(model);
+  int const nr_qconstrs = model.get(GRB_IntAttr_NumQConstrs);
+  std::unique_ptr<GRBQConstr[]> qconstrs(model.getQConstrs());
+  p_clone->m_source_qconstrs.assign(qconstrs.get(), qconstrs.get() + nr_qconstrs);
+  p_clone->m_objective_is_quadratic = m_objective_is_quadratic;
+  p_clone->m_objective_coeffs.invalidate();
+  // the copy is relaxed as the source, until it restores integrality.
+  for (auto const& relaxed_var: m_relaxed_vars)
+    p_clone->m_relaxed_vars.push_back({
+      p_clone->model.getVar(relaxed_var.var.index()),
+      relaxed_var.type,
+      relaxed_var.lb,
+      relaxed_var.ub
+    });
+  return p_clone;
+}
+
+std::shared_ptr<detail::IVar> GurobiSolver::clone_var(
+  Solver const& solver, detail::IVar const& var
+) const
+{
+  // the copy keeps the order of the variables and linear constraints.
+  int const idx = static_cast<GurobiVar const&>(var).m_var.index();
+  if (idx < 0)
+    return nullptr;
+  return std::make_shared<GurobiVar>(solver, model.getVar(idx));
+}
+
+bool GurobiSolver::bind_cloned_constr(Constr const& constr, Constr const& copy)
+{
+  if (auto p_constr = std::dynamic_pointer_cast<GurobiLinConstr>(constr.p_impl))
+  {
+    if (!p_constr->m_constr.has_value() or p_constr->m_constr->index() < 0)
+      return false;
+    static_cast<GurobiLinConstr const&>(*copy.p_impl).m_constr =
+      model.getConstr(p_constr->m_constr->index());
+    return true;
+  }
+
+  auto p_constr = std::dynamic_pointer_cast<GurobiQuadConstr>(constr.p_impl);
+  if (p_constr == nullptr or !p_constr->m_constr.has_value())
+    return false;
+  for (std::size_t i = 0; i < m_source_qconstrs.size(); ++i)
+  {
+    GRBQConstr source_qconstr = m_source_qconstrs[i];
+    if (source_qconstr.sameAs(p_constr->m_constr.value()))
+    {
+      std::unique_ptr<GRBQConstr[]> qconstrs(model.getQConstrs());
+      static_cast<GurobiQuadConstr const&>(*copy.p_impl).m_constr = qconstrs[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+void GurobiSolver::finish_clone(Solver::Remapping const&)
+{
+  m_source_qconstrs.clear();
+}
+
 namespace detail {
 
 GurobiCurrentStateHandle::GurobiCurrentStateHandle() : m_active(false)
@@ -526,6 +1083,9 @@ void GurobiCurrentStateHandle::add_lazy(Constr const& constr)
   auto const& e = constr.expr();
   auto const& type = constr.type();
 
+  if (type == Constr::Range)
+    throw std::logic_error("Gurobi does not support lazy range constraints.");
+
   if (e.is_linear())
   {
     GRBLinExpr lhs_expr = as_grb_lin_expr(e);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <miplib/solver.hpp>
+#include <miplib/util/objective.hpp>
 
 #include <gurobi_c++.h>
 
@@ -27,6 +28,8 @@ struct GurobiCurrentStateHandle : GRBCallback, ICurrentStateHandle
 struct GurobiSolver : detail::ISolver
 {
   GurobiSolver(bool verbose = true);
+  // copy of a model in a new environment.
+  GurobiSolver(GRBModel const& source);
   virtual ~GurobiSolver() {}
 
   std::shared_ptr<detail::IVar> create_var(
@@ -37,6 +40,17 @@ struct GurobiSolver : detail::ISolver
     std::optional<std::string> const& name
   );
 
+  std::shared_ptr<detail::IVar> create_column(
+    Solver const& solver,
+    Var::Type const& type,
+    std::optional<double> const& lb,
+    std::optional<double> const& ub,
+    double obj,
+    std::vector<Constr> const& constrs,
+    std::vector<double> const& coeffs,
+    std::optional<std::string> const& name
+  );
+
   std::shared_ptr<detail::IConstr> create_constr(
     Constr::Type const& type, Expr const& e, std::optional<std::string> const& name
   );
@@ -46,19 +60,51 @@ struct GurobiSolver : detail::ISolver
     Constr const& implicand,
     std::optional<std::string> const& name);
 
+  std::shared_ptr<detail::ISOSConstr> create_sos_constr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name);
+
+  std::shared_ptr<detail::IGenConstr> create_gen_constr(
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name);
+
+  std::shared_ptr<detail::IPwlConstr> create_pwl_constr(
+    Var const& x,
+    Var const& y,
+    std::vector<double> const& xs,
+    std::vector<double> const& ys,
+    std::optional<std::string> const& name);
+
   void set_objective(Solver::Sense const& sense, Expr const& e);
   double get_objective_value() const;
   Solver::Sense get_objective_sense() const;
 
   void add(Constr const& constr);
   void add(IndicatorConstr const& constr);
+  void add(SOSConstr const& constr);
+  void add(GenConstr const& constr);
+  void add(PwlConstr const& constr);
 
   void remove(Constr const& constr);
 
+  void set_coeff(Constr const& constr, Var const& var, double coeff);
+  void set_rhs(Constr const& constr, double rhs);
+
+  std::vector<double> get_duals(std::vector<Constr> const& constrs) const;
+  std::vector<double> get_reduced_costs(std::vector<Var> const& vars) const;
+
   void add_lazy_constr_handler(LazyConstrHandler const&, bool at_integral_only);
 
   std::pair<Solver::Result, bool> solve();
 
+  void relax_integrality(bool fix_integers);
+  void restore_integrality();
+  std::optional<DeclaredDomain> declared_domain(detail::IVar const& var) const;
+
   void set_non_convex_policy(Solver::NonConvexPolicy policy);
   void set_int_feasibility_tolerance(double value);
   void set_feasibility_tolerance(double value);
@@ -76,20 +122,32 @@ struct GurobiSolver : detail::ISolver
   bool supports_quadratic_objective() const { return true; }
 
   bool supports_indicator_constraint(IndicatorConstr const& i) const;
+  bool supports_sos_constraint(SOSConstr const& constr) const;
+  bool supports_gen_constraint(GenConstr const& constr) const;
+  bool supports_pwl_constraint(PwlConstr const& constr) const;
 
   double infinity() const;
 
   void set_time_limit(double secs);
+  void interrupt();
 
   void dump(std::string const& filename) const;
 
   bool is_in_callback() const;
   
   void set_warm_start(PartialSolution const& partial_solution);
+
+  std::optional<Solver::Basis> get_basis() const;
+  bool set_basis(Solver::Basis const& basis);
   
   void set_reoptimizing(bool);
   void setup_reoptimization();
 
+  std::shared_ptr<detail::ISolver> clone() const;
+  std::shared_ptr<detail::IVar> clone_var(Solver const& solver, detail::IVar const& var) const;
+  bool bind_cloned_constr(Constr const& constr, Constr const& copy);
+  void finish_clone(Solver::Remapping const&);
+
   static std::string backend_info();
 
   static bool is_available();
@@ -99,6 +157,17 @@ struct GurobiSolver : detail::ISolver
   mutable bool pending_update;
   mutable bool model_has_changed_since_last_solve;
   std::unique_ptr<detail::GurobiCurrentStateHandle> p_callback;
+  detail::ObjectiveCoefficients m_objective_coeffs;
+  bool m_objective_is_quadratic = false;
+
+  // variables relaxed by relax_integrality (by index) along with their
+  // type and bounds.
+  struct RelaxedVar { GRBVar var; char type; double lb; double ub; };
+  std::vector<RelaxedVar> m_relaxed_vars;
+
+  // in a copy, the quadratic constraints of the source model (these have
+  // no index), ordered as the copied ones.
+  std::vector<GRBQConstr> m_source_qconstrs;
 };
 
 }  // namespace miplib
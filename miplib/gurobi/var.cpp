@@ -30,7 +30,11 @@ double GurobiVar::value() const
 Var::Type GurobiVar::type() const
 {
   update_solver_if_pending();
-  char vtype = m_var.get(GRB_CharAttr_VType);
+  return gurobi_var_type(m_var.get(GRB_CharAttr_VType));
+}
+
+Var::Type gurobi_var_type(char vtype)
+{
   switch (vtype)
   {
     case 'C':
@@ -39,6 +43,10 @@ Var::Type GurobiVar::type() const
       return Var::Type::Binary;
     case 'I':
       return Var::Type::Integer;
+    case 'S':
+      return Var::Type::SemiContinuous;
+    case 'N':
+      return Var::Type::SemiInteger;
     default:
       throw std::logic_error("Gurobi variable type not handled yet.");
   }
@@ -5,6 +5,9 @@
 
 namespace miplib {
 
+// Type of a variable of the given Gurobi type.
+Var::Type gurobi_var_type(char vtype);
+
 struct GurobiVar : detail::IVar
 {
   GurobiVar(Solver const& solver, GRBVar const& v);
@@ -15,9 +15,26 @@ struct LpsolveConstr : detail::IConstr
   {}
 
   Solver m_solver;
+  // original row index as of the last renumbering of the posted rows,
+  // -1 if not posted.
   mutable int m_orig_row_idx;
 };
 
+struct LpsolveSOSConstr : detail::ISOSConstr
+{
+  LpsolveSOSConstr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name
+  ):
+    detail::ISOSConstr(type, vars, weights, name),
+    m_sos_idx(-1)
+  {}
+
+  mutable int m_sos_idx;
+};
+
 
 
 }  // namespace miplib
\ No newline at end of file
@@ -6,13 +6,24 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
 
 namespace miplib {
 
 
+// lpsolve polls the abort callback while solving.
+static int __WINAPI abort_if_interrupted(lprec*, void* p_solver)
+{
+  return static_cast<LpsolveSolver*>(p_solver)->m_interrupt_requested;
+}
+
 LpsolveSolver::LpsolveSolver(bool verbose): p_lprec(make_lp(0, 0))
 {
   set_verbose(verbose);
+  put_abortfunc(p_lprec, abort_if_interrupted, this);
 }
 
 
@@ -33,6 +44,33 @@ std::shared_ptr<detail::IVar> LpsolveSolver::create_var(
   return std::make_shared<LpsolveVar>(solver, type, lb, ub, name);
 }
 
+std::shared_ptr<detail::IVar> LpsolveSolver::create_column(
+  Solver const& solver,
+  Var::Type const& type,
+  std::optional<double> const& lb,
+  std::optional<double> const& ub,
+  double obj,
+  std::vector<Constr> const& constrs,
+  std::vector<double> const& coeffs,
+  std::optional<std::string> const& name
+)
+{
+  // row 0 is the objective.
+  std::vector<int> row_idxs = {0};
+  std::vector<double> column = {obj};
+  for (std::size_t i = 0; i < constrs.size(); ++i)
+  {
+    auto const& c = static_cast<LpsolveConstr const&>(*constrs[i].p_impl);
+    if (c.m_orig_row_idx < 0)
+      throw std::logic_error("Attempt to add a column to a constraint that was not posted.");
+    row_idxs.push_back(get_row_idx(c));
+    column.push_back(coeffs[i]);
+  }
+  auto p_var = std::make_shared<LpsolveVar>(solver, type, lb, ub, name, column, row_idxs);
+  m_objective_coeffs.record(p_var, obj);
+  return p_var;
+}
+
 std::shared_ptr<detail::IConstr> LpsolveSolver::create_constr(
   Constr::Type const& type, Expr const& e, std::optional<std::string> const& name
 )
@@ -49,6 +87,37 @@ std::shared_ptr<detail::IIndicatorConstr> LpsolveSolver::create_indicator_constr
   return detail::create_reformulatable_indicator_constr(implicant, implicand, name);
 }
 
+std::shared_ptr<detail::ISOSConstr> LpsolveSolver::create_sos_constr(
+  SOSConstr::Type const& type,
+  std::vector<Var> const& vars,
+  std::vector<double> const& weights,
+  std::optional<std::string> const& name
+)
+{
+  return std::make_shared<LpsolveSOSConstr>(type, vars, weights, name);
+}
+
+std::shared_ptr<detail::IGenConstr> LpsolveSolver::create_gen_constr(
+  GenConstr::Type const& type,
+  Var const& resultant,
+  std::vector<Var> const& operands,
+  std::optional<std::string> const& name
+)
+{
+  return detail::create_reformulatable_gen_constr(type, resultant, operands, name);
+}
+
+std::shared_ptr<detail::IPwlConstr> LpsolveSolver::create_pwl_constr(
+  Var const& x,
+  Var const& y,
+  std::vector<double> const& xs,
+  std::vector<double> const& ys,
+  std::optional<std::string> const& name
+)
+{
+  return detail::create_reformulatable_pwl_constr(x, y, xs, ys, name);
+}
+
 std::vector<int> LpsolveSolver::get_col_idxs(std::vector<Var> const& vars)
 {
   std::vector<int> r;
@@ -67,12 +136,22 @@ void LpsolveSolver::set_objective(Solver::Sense const& sense, Expr const& e)
 {
   if (e.is_linear())
   {
-    auto col_idxs = get_col_idxs(e.linear_vars());  
-    auto coeffs = e.linear_coeffs();
-
-    bool r = set_obj_fnex(p_lprec, col_idxs.size(), coeffs.data(), col_idxs.data());
-    if (!r)
-      throw std::logic_error("Lpsolve error setting objective.");
+    // only the coefficients that changed are posted, all of them being
+    // reset first if these are unknown.
+    auto changes = m_objective_coeffs.update(e);
+    if (!changes.has_value())
+    {
+      if (!set_obj_fnex(p_lprec, 0, NULL, NULL))
+        throw std::logic_error("Lpsolve error setting objective.");
+      m_objective_coeffs.reset(Expr());
+      changes = m_objective_coeffs.update(e);
+    }
+    for (auto const& [p_var, coeff]: changes.value())
+    {
+      auto col_idx = static_cast<LpsolveVar const&>(*p_var).cur_col_idx();
+      if (!set_obj(p_lprec, col_idx, coeff))
+        throw std::logic_error("Lpsolve error setting objective.");
+    }
   }
   else
   if (e.is_quadratic())
@@ -113,12 +192,12 @@ void LpsolveSolver::add(Constr const& constr)
   auto coeffs = e.linear_coeffs();
 
   int constr_type;
-  if (constr.type() == Constr::Type::LessEqual)
-    constr_type = 1;
+  if (constr.type() == Constr::Type::Equal)
+    constr_type = 3;
   else
   {
-    assert(constr.type() == Constr::Type::Equal);
-    constr_type = 3;
+    // range constraints are posted as <= rows and then given their width.
+    constr_type = 1;
   }
 
   bool r = add_constraintex(
@@ -127,7 +206,78 @@ void LpsolveSolver::add(Constr const& constr)
   if (!r)
     throw std::logic_error("Lpsolve error adding constraint.");
 
-  constr_impl.m_orig_row_idx = get_Nrows(p_lprec);
+  // numbered as if the rows removed since the last renumbering were
+  // still there.
+  constr_impl.m_orig_row_idx = get_Norig_rows(p_lprec) + m_removed_rows.size();
+  m_posted_rows.push_back(constr.p_impl);
+
+  if (constr.type() == Constr::Type::Range)
+    if (!set_rh_range(p_lprec, get_Nrows(p_lprec), constr.width()))
+      throw std::logic_error("Lpsolve error setting constraint range.");
+}
+
+void LpsolveSolver::set_coeff(Constr const& constr, Var const& var, double coeff)
+{
+  auto const& constr_impl = static_cast<LpsolveConstr const&>(*constr.p_impl);
+  if (constr_impl.m_orig_row_idx < 0)
+    throw std::logic_error("Attempt to modify a constraint that was not posted.");
+
+  auto col_idx = get_col_idxs({var}).front();
+  auto row_idx = get_row_idx(constr_impl);
+  if (!set_mat(p_lprec, row_idx, col_idx, coeff))
+    throw std::logic_error("Lpsolve error setting constraint coefficient.");
+}
+
+void LpsolveSolver::set_rhs(Constr const& constr, double rhs)
+{
+  auto const& constr_impl = static_cast<LpsolveConstr const&>(*constr.p_impl);
+  if (constr_impl.m_orig_row_idx < 0)
+    throw std::logic_error("Attempt to modify a constraint that was not posted.");
+
+  // range rows keep their width.
+  if (!set_rh(p_lprec, get_row_idx(constr_impl), rhs))
+    throw std::logic_error("Lpsolve error setting constraint right-hand side.");
+}
+
+// lpsolve returns the dual values of all the rows followed by the
+// reduced costs of all the columns in a single array.
+static REAL* get_duals_array(lprec* p_lprec)
+{
+  REAL* p_duals;
+  if (!get_ptr_sensitivity_rhs(p_lprec, &p_duals, nullptr, nullptr))
+    throw std::logic_error("Lpsolve error retrieving dual values.");
+  return p_duals;
+}
+
+std::vector<double> LpsolveSolver::get_duals(std::vector<Constr> const& constrs) const
+{
+  std::vector<double> r;
+  if (constrs.empty())
+    return r;
+  auto const p_duals = get_duals_array(p_lprec);
+  for (auto const& constr: constrs)
+  {
+    auto const& constr_impl = static_cast<LpsolveConstr const&>(*constr.p_impl);
+    if (constr_impl.m_orig_row_idx < 0)
+      throw std::logic_error("Attempt to query a constraint that was not posted.");
+    r.push_back(p_duals[get_row_idx(constr_impl) - 1]);
+  }
+  return r;
+}
+
+std::vector<double> LpsolveSolver::get_reduced_costs(std::vector<Var> const& vars) const
+{
+  std::vector<double> r;
+  if (vars.empty())
+    return r;
+  auto const p_duals = get_duals_array(p_lprec);
+  int const nr_rows = get_Nrows(p_lprec);
+  for (auto const& v: vars)
+  {
+    auto const& var_impl = static_cast<LpsolveVar const&>(*v.p_impl);
+    r.push_back(p_duals[nr_rows + var_impl.cur_col_idx() - 1]);
+  }
+  return r;
 }
 
 bool LpsolveSolver::supports_indicator_constraint(IndicatorConstr const&) const
@@ -140,18 +290,170 @@ void LpsolveSolver::add(IndicatorConstr const&)
   throw std::logic_error("Lpsolve does not support indicator constraints.");
 }
 
-void LpsolveSolver::remove(Constr const&)
+bool LpsolveSolver::supports_sos_constraint(SOSConstr const& constr) const
+{
+  // Lpsolve branches on SOS constraints by fixing variable upper bounds to zero,
+  // which requires non-negative variables.
+  for (auto const& v: constr.vars())
+    if (v.lb() < 0)
+      return false;
+  return true;
+}
+
+void LpsolveSolver::add(SOSConstr const& constr)
+{
+  auto const& constr_impl = static_cast<LpsolveSOSConstr const&>(*constr.p_impl);
+
+  if (constr_impl.m_sos_idx >= 0)
+  {
+    throw std::logic_error("Attempt to post the same constraint twice.");
+  }
+
+  if (!supports_sos_constraint(constr))
+    throw std::logic_error(
+      "Lpsolve does not support SOS constraints over possibly negative variables."
+      " Try .reformulation()."
+    );
+
+  auto col_idxs = get_col_idxs(constr.vars());
+  std::vector<double> weights = constr.weights();
+  std::string name = constr.name().value_or("");
+
+  int sos_idx = add_SOS(
+    p_lprec,
+    name.data(),
+    (constr.type() == SOSConstr::SOS1) ? 1 : 2,
+    1,
+    col_idxs.size(),
+    col_idxs.data(),
+    weights.data()
+  );
+  if (sos_idx == 0)
+    throw std::logic_error("Lpsolve error adding SOS constraint.");
+
+  constr_impl.m_sos_idx = sos_idx;
+}
+
+bool LpsolveSolver::supports_gen_constraint(GenConstr const&) const
 {
-  // TODO: removing a constraint changes other constraints idxs, 
-  // meaning we need to keep track of them and update them accordingly.
-  throw std::logic_error("Not implemented yet.");
+  return false;
+}
+
+void LpsolveSolver::add(GenConstr const&)
+{
+  throw std::logic_error("Lpsolve does not support general constraints.");
+}
+
+bool LpsolveSolver::supports_pwl_constraint(PwlConstr const&) const
+{
+  return false;
+}
+
+void LpsolveSolver::add(PwlConstr const&)
+{
+  throw std::logic_error("Lpsolve does not support piecewise linear constraints.");
+}
+
+void LpsolveSolver::remove(Constr const& constr)
+{
+  remove_constrs({constr});
+}
+
+// Rows are deleted at once, lpsolve keeping those left in its row map.
+// Unless lpsolve keeps track of the original indices (once it solved or
+// names are used), deleting rows shifts the original indices of the
+// following ones: rather than renumbering all the posted rows on every
+// such removal, the removed indices are recorded and subtracted when
+// looking up a row, the posted rows being renumbered once enough of them
+// accumulated.
+void LpsolveSolver::remove_constrs(std::vector<Constr> const& constrs)
+{
+  std::vector<int> orig_row_idxs, row_idxs;
+  for (auto const& constr: constrs)
+  {
+    auto const& constr_impl = static_cast<LpsolveConstr const&>(*constr.p_impl);
+    if (constr_impl.m_orig_row_idx < 0)
+      throw std::logic_error("Attempt to remove a constraint that was not posted.");
+    orig_row_idxs.push_back(constr_impl.m_orig_row_idx);
+    row_idxs.push_back(get_row_idx(constr_impl));
+  }
+  std::sort(orig_row_idxs.begin(), orig_row_idxs.end());
+  std::sort(row_idxs.begin(), row_idxs.end());
+  if (std::adjacent_find(row_idxs.begin(), row_idxs.end()) != row_idxs.end())
+    throw std::logic_error("Attempt to remove the same constraint twice.");
+
+  int const nr_rows = get_Nrows(p_lprec);
+  int const nr_orig_rows = get_Norig_rows(p_lprec);
+  LLrec* p_row_map = nullptr;
+  if (createLink(nr_rows, &p_row_map, nullptr) < 0)
+    throw std::logic_error("Lpsolve error removing constraint.");
+  auto it = row_idxs.begin();
+  for (int i = 1; i <= nr_rows; ++i)
+  {
+    if (it != row_idxs.end() and *it == i)
+      ++it;
+    else
+      appendLink(p_row_map, i);
+  }
+  bool const r = del_constraintex(p_lprec, p_row_map);
+  freeLink(&p_row_map);
+  if (!r)
+    throw std::logic_error("Lpsolve error removing constraint.");
+
+  for (auto const& constr: constrs)
+    static_cast<LpsolveConstr const&>(*constr.p_impl).m_orig_row_idx = -1;
+  if (get_Norig_rows(p_lprec) == nr_orig_rows)
+    return;
+  std::vector<int> removed_rows;
+  std::merge(
+    m_removed_rows.begin(), m_removed_rows.end(),
+    orig_row_idxs.begin(), orig_row_idxs.end(),
+    std::back_inserter(removed_rows)
+  );
+  m_removed_rows = std::move(removed_rows);
+  if (4 * m_removed_rows.size() > m_posted_rows.size())
+    renumber_rows();
+}
+
+int LpsolveSolver::get_orig_row_idx(LpsolveConstr const& constr) const
+{
+  int const nr_removed_before = std::lower_bound(
+    m_removed_rows.begin(), m_removed_rows.end(), constr.m_orig_row_idx
+  ) - m_removed_rows.begin();
+  return constr.m_orig_row_idx - nr_removed_before;
+}
+
+int LpsolveSolver::get_row_idx(LpsolveConstr const& constr) const
+{
+  return get_cur_row_index(p_lprec, get_orig_row_idx(constr));
+}
+
+// Gives the posted rows their current original indices, dropping those
+// removed or no longer referenced.
+void LpsolveSolver::renumber_rows() const
+{
+  std::vector<std::weak_ptr<detail::IConstr>> posted_rows;
+  for (auto const& p_constr: m_posted_rows)
+  {
+    auto p = p_constr.lock();
+    if (p == nullptr)
+      continue;
+    auto const& constr_impl = static_cast<LpsolveConstr const&>(*p);
+    if (constr_impl.m_orig_row_idx < 0)
+      continue;
+    constr_impl.m_orig_row_idx = get_orig_row_idx(constr_impl);
+    posted_rows.push_back(p_constr);
+  }
+  m_posted_rows = std::move(posted_rows);
+  m_removed_rows.clear();
 }
 
 std::pair<Solver::Result, bool> LpsolveSolver::solve()
 {
-  // presolve
-  int PRESOLVE_TRY_ALL_TRICKS = std::numeric_limits<int>::max();
-  set_presolve(p_lprec, PRESOLVE_TRY_ALL_TRICKS, get_presolveloops(p_lprec));
+  // only the sensitivity analysis: lpsolve's presolve removes rows and
+  // columns for good (losing their duals and the ability to modify them)
+  // and discards a starting basis
+  set_presolve(p_lprec, PRESOLVE_SENSDUALS, get_presolveloops(p_lprec));
 
   int status = ::solve(p_lprec);
 
@@ -249,6 +551,78 @@ void LpsolveSolver::set_verbose(bool value)
 }
 
 
+// Columns removed by presolve are skipped.
+void LpsolveSolver::relax_integrality(bool fix_integers)
+{
+  if (fix_integers and m_last_solution.empty())
+    throw std::logic_error("Attempt to fix integers without a solution.");
+
+  restore_integrality();
+  int const nr_orig_rows = get_Norig_rows(p_lprec);
+  int const nr_orig_columns = get_Norig_columns(p_lprec);
+  for (int i = 1; i <= nr_orig_columns; ++i)
+  {
+    int const col_idx = get_lp_index(p_lprec, nr_orig_rows + i);
+    if (col_idx == 0)
+      continue;
+    bool const col_is_int = is_int(p_lprec, col_idx);
+    bool const col_is_semicont = is_semicont(p_lprec, col_idx);
+    if (!col_is_int and !col_is_semicont)
+      continue;
+    double const lb = get_lowbo(p_lprec, col_idx);
+    double const ub = get_upbo(p_lprec, col_idx);
+    m_relaxed_cols.push_back({i, col_is_int, col_is_semicont, lb, ub});
+
+    auto const [new_lb, new_ub] = detail::relaxed_bounds(
+      col_is_int, col_is_semicont, lb, ub,
+      fix_integers ? std::optional<double>(m_last_solution[i - 1]) : std::nullopt,
+      get_feasibility_tolerance()
+    );
+    set_int(p_lprec, col_idx, false);
+    set_semicont(p_lprec, col_idx, false);
+    set_bounds(p_lprec, col_idx, new_lb, new_ub);
+  }
+}
+
+void LpsolveSolver::restore_integrality()
+{
+  int const nr_orig_rows = get_Norig_rows(p_lprec);
+  for (auto const& relaxed_col: m_relaxed_cols)
+  {
+    int const col_idx = get_lp_index(p_lprec, nr_orig_rows + relaxed_col.orig_col_idx);
+    if (col_idx == 0)
+      continue;
+    set_bounds(p_lprec, col_idx, relaxed_col.lb, relaxed_col.ub);
+    set_int(p_lprec, col_idx, relaxed_col.is_int);
+    set_semicont(p_lprec, col_idx, relaxed_col.is_semicont);
+  }
+  m_relaxed_cols.clear();
+}
+
+std::optional<detail::ISolver::DeclaredDomain> LpsolveSolver::declared_domain(
+  detail::IVar const& var
+) const
+{
+  if (m_relaxed_cols.empty())
+    return std::nullopt;
+  int const orig_col_idx = static_cast<LpsolveVar const&>(var).m_orig_col_idx;
+  auto it = std::lower_bound(
+    m_relaxed_cols.begin(), m_relaxed_cols.end(), orig_col_idx,
+    [](auto const& relaxed_col, int idx) { return relaxed_col.orig_col_idx < idx; }
+  );
+  if (it == m_relaxed_cols.end() or it->orig_col_idx != orig_col_idx)
+    return std::nullopt;
+
+  // as lpsolve, binaries are integers within 0..1.
+  Var::Type type = Var::Type::Integer;
+  if (it->is_semicont)
+    type = it->is_int ? Var::Type::SemiInteger : Var::Type::SemiContinuous;
+  else
+  if (it->lb == 0 and it->ub == 1)
+    type = Var::Type::Binary;
+  return DeclaredDomain{type, it->lb, it->ub};
+}
+
 double LpsolveSolver::infinity() const
 {
   return get_infinite(p_lprec);
@@ -259,6 +633,16 @@ void LpsolveSolver::set_time_limit(double secs)
   set_timeout(p_lprec, (long) std::ceil(secs));
 }
 
+void LpsolveSolver::interrupt()
+{
+  m_interrupt_requested = true;
+}
+
+void LpsolveSolver::clear_interrupt()
+{
+  m_interrupt_requested = false;
+}
+
 void LpsolveSolver::dump(std::string const& filename) const
 {
   std::string ext = filename.substr(filename.size()-3);
@@ -273,9 +657,188 @@ void LpsolveSolver::dump(std::string const& filename) const
     );
 }
 
-void LpsolveSolver::set_warm_start(PartialSolution const& /*partial_solution*/)
+// Lpsolve has no MIP start: the solution (completed by the last one found,
+// or the values closest to zero) is turned into a starting basis with
+// guess_basis, and branching on integer columns first goes towards it.
+void LpsolveSolver::set_warm_start(PartialSolution const& partial_solution)
+{
+  int const nr_rows = get_Nrows(p_lprec);
+  int const nr_cols = get_Ncolumns(p_lprec);
+  int const nr_orig_rows = get_Norig_rows(p_lprec);
+
+  std::vector<REAL> guess(1 + nr_cols);
+  for (int j = 1; j <= nr_cols; ++j)
+  {
+    std::size_t const orig_col_idx = get_orig_index(p_lprec, nr_rows + j) - nr_orig_rows;
+    double const lb = get_lowbo(p_lprec, j);
+    double const ub = get_upbo(p_lprec, j);
+    // crossing bounds (an infeasible column) give their lower one.
+    guess[j] = orig_col_idx <= m_last_solution.size() ?
+      m_last_solution[orig_col_idx - 1] :
+      (lb <= ub ? std::clamp(0.0, lb, ub) : lb);
+  }
+  for (auto const& [var, val]: partial_solution)
+    guess[static_cast<LpsolveVar const&>(*var.p_impl).cur_col_idx()] = val;
+
+  std::vector<int> bascolumn(1 + nr_rows + nr_cols);
+  if (!guess_basis(p_lprec, guess.data(), bascolumn.data()))
+    throw std::logic_error("Lpsolve error guessing basis from warm start.");
+  if (!::set_basis(p_lprec, bascolumn.data(), true))
+    throw std::logic_error("Lpsolve error setting basis.");
+
+  for (int j = 1; j <= nr_cols; ++j)
+  {
+    if (!is_int(p_lprec, j))
+      continue;
+    double const mid = (get_lowbo(p_lprec, j) + get_upbo(p_lprec, j)) / 2;
+    set_var_branch(p_lprec, j, guess[j] > mid ? BRANCH_CEILING : BRANCH_FLOOR);
+  }
+}
+
+// Lpsolve lists the basic rows and columns (rows first) followed by the
+// nonbasic ones, the sign telling at which bound they are.
+std::optional<Solver::Basis> LpsolveSolver::get_basis() const
+{
+  if (m_last_solution.empty())
+    return std::nullopt;
+  int const nr_rows = get_Nrows(p_lprec);
+  int const nr_cols = get_Ncolumns(p_lprec);
+  for (int j = 1; j <= nr_cols; ++j)
+    if (is_int(p_lprec, j) or is_semicont(p_lprec, j))
+      return std::nullopt;
+
+  std::vector<int> bascolumn(1 + nr_rows + nr_cols);
+  if (!::get_basis(p_lprec, bascolumn.data(), true))
+    return std::nullopt;
+
+  Solver::Basis r;
+  r.constrs.resize(nr_rows);
+  r.vars.resize(nr_cols);
+  for (int i = 1; i <= nr_rows + nr_cols; ++i)
+  {
+    int const idx = std::abs(bascolumn[i]);
+    auto& status = idx <= nr_rows ? r.constrs[idx - 1] : r.vars[idx - nr_rows - 1];
+    if (i <= nr_rows)
+      status = Solver::BasisStatus::Basic;
+    else
+      status = bascolumn[i] < 0 ? Solver::BasisStatus::AtLower : Solver::BasisStatus::AtUpper;
+  }
+  return r;
+}
+
+bool LpsolveSolver::set_basis(Solver::Basis const& basis)
+{
+  int const nr_rows = get_Nrows(p_lprec);
+  int const nr_cols = get_Ncolumns(p_lprec);
+  if (basis.constrs.size() != std::size_t(nr_rows) or basis.vars.size() != std::size_t(nr_cols))
+    return false;
+
+  std::vector<int> basic, nonbasic;
+  auto const add = [&](int idx, Solver::BasisStatus status) {
+    if (status == Solver::BasisStatus::Basic)
+      basic.push_back(-idx);
+    else
+      nonbasic.push_back(status == Solver::BasisStatus::AtUpper ? idx : -idx);
+  };
+  for (int i = 1; i <= nr_rows; ++i)
+    add(i, basis.constrs[i - 1]);
+  for (int j = 1; j <= nr_cols; ++j)
+    add(nr_rows + j, basis.vars[j - 1]);
+  if (basic.size() != std::size_t(nr_rows))
+    throw std::logic_error("Attempt to set a basis with a wrong number of basic variables.");
+
+  std::vector<int> bascolumn = {0};
+  bascolumn.insert(bascolumn.end(), basic.begin(), basic.end());
+  bascolumn.insert(bascolumn.end(), nonbasic.begin(), nonbasic.end());
+  if (!::set_basis(p_lprec, bascolumn.data(), true))
+    throw std::logic_error("Lpsolve error setting basis.");
+  return true;
+}
+
+// Rows and columns removed by presolve are not copied, those left being
+// mapped through their current indices.
+static std::map<int, int> copied_indices(
+  lprec* p_source, lprec* p_copy, int nr_source, int nr_copy, int source_offset, int copy_offset
+)
+{
+  std::map<int, int> copy_orig_idxs;
+  for (int i = 1; i <= nr_copy; ++i)
+  {
+    int cur_idx = get_lp_index(p_copy, copy_offset + i);
+    if (cur_idx != 0)
+      copy_orig_idxs[cur_idx] = i;
+  }
+
+  std::map<int, int> r;
+  for (int i = 1; i <= nr_source; ++i)
+  {
+    auto it = copy_orig_idxs.find(get_lp_index(p_source, source_offset + i));
+    if (it != copy_orig_idxs.end())
+      r[i] = it->second;
+  }
+  return r;
+}
+
+std::shared_ptr<detail::ISolver> LpsolveSolver::clone() const
+{
+  auto p_clone = std::make_shared<LpsolveSolver>(false);
+  delete_lp(p_clone->p_lprec);
+  p_clone->p_lprec = copy_lp(p_lprec);
+  if (p_clone->p_lprec == nullptr)
+    throw std::logic_error("Lpsolve error copying model.");
+  put_abortfunc(p_clone->p_lprec, abort_if_interrupted, p_clone.get());
+  // the rows of the source are then found by their current indices.
+  renumber_rows();
+
+  auto p_copy = p_clone->p_lprec;
+  p_clone->m_source_rows = copied_indices(
+    p_lprec, p_copy, get_Norig_rows(p_lprec), get_Norig_rows(p_copy), 0, 0
+  );
+  p_clone->m_source_cols = copied_indices(
+    p_lprec,
+    p_copy,
+    get_Norig_columns(p_lprec),
+    get_Norig_columns(p_copy),
+    get_Norig_rows(p_lprec),
+    get_Norig_rows(p_copy)
+  );
+  p_clone->m_objective_coeffs.invalidate();
+  // the copy is relaxed as the source, until it restores integrality.
+  for (auto relaxed_col: m_relaxed_cols)
+  {
+    auto it = p_clone->m_source_cols.find(relaxed_col.orig_col_idx);
+    if (it == p_clone->m_source_cols.end())
+      continue;
+    relaxed_col.orig_col_idx = it->second;
+    p_clone->m_relaxed_cols.push_back(relaxed_col);
+  }
+  return p_clone;
+}
+
+std::shared_ptr<detail::IVar> LpsolveSolver::clone_var(
+  Solver const& solver, detail::IVar const& var
+) const
+{
+  auto it = m_source_cols.find(static_cast<LpsolveVar const&>(var).m_orig_col_idx);
+  if (it == m_source_cols.end())
+    return nullptr;
+  return std::make_shared<LpsolveVar>(solver, it->second);
+}
+
+bool LpsolveSolver::bind_cloned_constr(Constr const& constr, Constr const& copy)
+{
+  auto it = m_source_rows.find(static_cast<LpsolveConstr const&>(*constr.p_impl).m_orig_row_idx);
+  if (it == m_source_rows.end())
+    return false;
+  static_cast<LpsolveConstr const&>(*copy.p_impl).m_orig_row_idx = it->second;
+  m_posted_rows.push_back(copy.p_impl);
+  return true;
+}
+
+void LpsolveSolver::finish_clone(Solver::Remapping const&)
 {
-  throw std::logic_error("Lpsolve does not support warm starts.");
+  m_source_rows.clear();
+  m_source_cols.clear();
 }
 
 void LpsolveSolver::set_reoptimizing(bool)
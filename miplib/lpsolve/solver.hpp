@@ -1,11 +1,16 @@
 #pragma once
 
 #include <miplib/solver.hpp>
+#include <miplib/util/objective.hpp>
 
 #include <lpsolve/lp_lib.h>
 
+#include <atomic>
+
 namespace miplib {
 
+struct LpsolveConstr;
+
 struct LpsolveSolver : detail::ISolver
 {
   LpsolveSolver(bool verbose);
@@ -19,6 +24,17 @@ struct LpsolveSolver : detail::ISolver
     std::optional<std::string> const& name
   );
 
+  std::shared_ptr<detail::IVar> create_column(
+    Solver const& solver,
+    Var::Type const& type,
+    std::optional<double> const& lb,
+    std::optional<double> const& ub,
+    double obj,
+    std::vector<Constr> const& constrs,
+    std::vector<double> const& coeffs,
+    std::optional<std::string> const& name
+  );
+
   std::shared_ptr<detail::IConstr> create_constr(
     Constr::Type const& type, Expr const& e, std::optional<std::string> const& name
   );
@@ -29,19 +45,55 @@ struct LpsolveSolver : detail::ISolver
     std::optional<std::string> const& name
   );
 
+  std::shared_ptr<detail::ISOSConstr> create_sos_constr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name
+  );
+
+  std::shared_ptr<detail::IGenConstr> create_gen_constr(
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name
+  );
+
+  std::shared_ptr<detail::IPwlConstr> create_pwl_constr(
+    Var const& x,
+    Var const& y,
+    std::vector<double> const& xs,
+    std::vector<double> const& ys,
+    std::optional<std::string> const& name
+  );
+
   void set_objective(Solver::Sense const& sense, Expr const& e);
   double get_objective_value() const;
   Solver::Sense get_objective_sense() const;
 
   void add(Constr const& constr);
   void add(IndicatorConstr const& constr);
+  void add(SOSConstr const& constr);
+  void add(GenConstr const& constr);
+  void add(PwlConstr const& constr);
 
   void remove(Constr const& constr);
+  void remove_constrs(std::vector<Constr> const& constrs);
+
+  void set_coeff(Constr const& constr, Var const& var, double coeff);
+  void set_rhs(Constr const& constr, double rhs);
+
+  std::vector<double> get_duals(std::vector<Constr> const& constrs) const;
+  std::vector<double> get_reduced_costs(std::vector<Var> const& vars) const;
 
   void add_lazy_constr_handler(LazyConstrHandler const&, bool) { throw std::logic_error("Not implemented yet."); }
 
   std::pair<Solver::Result, bool> solve();
 
+  void relax_integrality(bool fix_integers);
+  void restore_integrality();
+  std::optional<DeclaredDomain> declared_domain(detail::IVar const& var) const;
+
   void set_non_convex_policy(Solver::NonConvexPolicy policy);
 
   void set_int_feasibility_tolerance(double value);
@@ -56,8 +108,14 @@ struct LpsolveSolver : detail::ISolver
   void set_verbose(bool value);
 
   std::vector<int> get_col_idxs(std::vector<Var> const& vars);
+  int get_orig_row_idx(LpsolveConstr const& constr) const;
+  int get_row_idx(LpsolveConstr const& constr) const;
+  void renumber_rows() const;
 
   bool supports_indicator_constraint(IndicatorConstr const& constr) const;
+  bool supports_sos_constraint(SOSConstr const& constr) const;
+  bool supports_gen_constraint(GenConstr const& constr) const;
+  bool supports_pwl_constraint(PwlConstr const& constr) const;
 
   bool supports_quadratic_constraints() const { return false; }
   bool supports_quadratic_objective() const { return false; }
@@ -65,20 +123,49 @@ struct LpsolveSolver : detail::ISolver
   double infinity() const;
 
   void set_time_limit(double secs);
+  void interrupt();
+  void clear_interrupt();
 
   void dump(std::string const& filename) const;
 
   void set_warm_start(PartialSolution const& partial_solution);
 
+  std::optional<Solver::Basis> get_basis() const;
+  bool set_basis(Solver::Basis const& basis);
+
   void set_reoptimizing(bool);
   void setup_reoptimization();
 
+  std::shared_ptr<detail::ISolver> clone() const;
+  std::shared_ptr<detail::IVar> clone_var(Solver const& solver, detail::IVar const& var) const;
+  bool bind_cloned_constr(Constr const& constr, Constr const& copy);
+  void finish_clone(Solver::Remapping const&);
+
   static std::string backend_info();
 
   static bool is_available();
 
   lprec* p_lprec;
+  // set by interrupt(), from another thread, until clear_interrupt().
+  std::atomic<bool> m_interrupt_requested{false};
   std::vector<double> m_last_solution;
+  detail::ObjectiveCoefficients m_objective_coeffs;
+  // rows posted so far (without keeping them alive), whose indices are
+  // updated when rows are removed, along with the (sorted) indices of the
+  // rows removed since the last update whose removal shifted the
+  // original indices of the following ones.
+  mutable std::vector<std::weak_ptr<detail::IConstr>> m_posted_rows;
+  mutable std::vector<int> m_removed_rows;
+
+  // columns (by original index) relaxed by relax_integrality along with
+  // their integrality, semi-continuity and bounds.
+  struct RelaxedCol { int orig_col_idx; bool is_int; bool is_semicont; double lb; double ub; };
+  std::vector<RelaxedCol> m_relaxed_cols;
+
+  // in a copy, the original indices in the copy of the rows and columns
+  // of the source model, by original index in the source.
+  std::map<int, int> m_source_rows;
+  std::map<int, int> m_source_cols;
 };
 
 }  // namespace miplib
@@ -9,14 +9,26 @@ LpsolveVar::LpsolveVar(
   Var::Type const& type,
   std::optional<double> const& lb,
   std::optional<double> const& ub,
-  std::optional<std::string> const& name
+  std::optional<std::string> const& name,
+  std::vector<double> column,
+  std::vector<int> row_idxs
 ):
   m_solver(solver)
 {
   auto p_lprec = static_cast<LpsolveSolver const&>(*m_solver.p_impl).p_lprec;
 
+  bool const is_semi =
+    type == Var::Type::SemiContinuous or type == Var::Type::SemiInteger;
+
+  // Lpsolve semi-continuous variables are either zero or within
+  // [lb, ub], ub being mandatory.
+  if (is_semi and (!ub.has_value() or lb.value_or(0) < 0))
+    throw std::logic_error(
+      "Lpsolve semi-continuous variables require a non-negative lower bound and an upper bound."
+    );
+
   // create var
-  bool success = add_columnex(p_lprec, 0, NULL, NULL);
+  bool success = add_columnex(p_lprec, column.size(), column.data(), row_idxs.data());
   if (!success)
     throw std::logic_error("Lpsolve error creating variable.");
 
@@ -27,12 +39,15 @@ LpsolveVar::LpsolveVar(
   if (type == Var::Type::Binary)
     set_binary(p_lprec, m_orig_col_idx, 1);
   else
-  if (type == Var::Type::Integer)
+  if (type == Var::Type::Integer or type == Var::Type::SemiInteger)
     set_int(p_lprec, m_orig_col_idx, 1);
   else
-  if (type != Var::Type::Continuous)
+  if (type != Var::Type::Continuous and type != Var::Type::SemiContinuous)
     throw std::logic_error("Lpsolve does not support this variable type");
 
+  if (is_semi)
+    set_semicont(p_lprec, m_orig_col_idx, 1);
+
   // set bounds
   if (type != Var::Type::Binary)
   {
@@ -40,7 +55,7 @@ LpsolveVar::LpsolveVar(
     success = set_bounds(
       p_lprec,
       m_orig_col_idx,
-      lb ? lb.value() : -inf,
+      lb ? lb.value() : (is_semi ? 0 : -inf),
       ub ? ub.value() : inf
     );
     if (!success)
@@ -87,6 +102,9 @@ Var::Type LpsolveVar::type() const
   if (is_binary(p_lprec, col_idx))
     return Var::Type::Binary;
   else
+  if (is_semicont(p_lprec, col_idx))
+    return is_int(p_lprec, col_idx) ? Var::Type::SemiInteger : Var::Type::SemiContinuous;
+  else
   if (is_int(p_lprec, col_idx))
     return Var::Type::Integer;
   else
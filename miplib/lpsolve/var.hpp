@@ -13,8 +13,14 @@ struct LpsolveVar : detail::IVar
     Var::Type const& type,
     std::optional<double> const& lb,
     std::optional<double> const& ub,
-    std::optional<std::string> const& name
+    std::optional<std::string> const& name,
+    std::vector<double> column = {},
+    std::vector<int> row_idxs = {}
   );
+  // Counterpart of a variable in a copy of its model, given its column.
+  LpsolveVar(Solver const& solver, std::size_t orig_col_idx):
+    m_solver(solver), m_orig_col_idx(orig_col_idx)
+  {}
   virtual ~LpsolveVar() {}
 
   double value() const;
@@ -65,4 +65,54 @@ struct ScipIndicatorConstr : detail::IIndicatorConstr
 };
 
 
-}  // namespace miplib
\ No newline at end of file
+struct ScipSOSConstr : detail::ISOSConstr
+{
+  ScipSOSConstr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name
+  ):
+    detail::ISOSConstr(type, vars, weights, name),
+    m_solver(vars.front().solver()), p_constr(nullptr)
+  {}
+
+  virtual ~ScipSOSConstr()
+  {
+    if (p_constr == nullptr)
+      return;
+    auto p_env = static_cast<ScipSolver const&>(*m_solver.p_impl).p_env;
+    SCIP_CALL_TERM(SCIPreleaseCons(p_env, &p_constr));
+  }
+
+  Solver m_solver;
+  mutable SCIP_CONS* p_constr;
+};
+
+
+struct ScipGenConstr : detail::IGenConstr
+{
+  ScipGenConstr(
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name
+  ):
+    detail::IGenConstr(type, resultant, operands, name),
+    m_solver(resultant.solver()), p_constr(nullptr)
+  {}
+
+  virtual ~ScipGenConstr()
+  {
+    if (p_constr == nullptr)
+      return;
+    auto p_env = static_cast<ScipSolver const&>(*m_solver.p_impl).p_env;
+    SCIP_CALL_TERM(SCIPreleaseCons(p_env, &p_constr));
+  }
+
+  Solver m_solver;
+  mutable SCIP_CONS* p_constr;
+};
+
+
+}  // namespace miplib
@@ -15,10 +15,13 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <functional>
+
 namespace miplib {
 
 
-ScipSolver::ScipSolver(bool verbose): p_env(nullptr), p_sol(nullptr), p_aux_obj_var(nullptr)
+ScipSolver::ScipSolver(bool verbose): p_env(nullptr), p_sol(nullptr), p_aux_obj_var(nullptr), p_aux_obj_constr(nullptr)
 {
   SCIP_CALL_EXC(SCIPcreate(&p_env));
   SCIP_CALL_EXC(SCIPincludeDefaultPlugins(p_env));
@@ -32,6 +35,9 @@ ScipSolver::ScipSolver(bool verbose): p_env(nullptr), p_sol(nullptr), p_aux_obj_
 
 ScipSolver::~ScipSolver()
 {
+  if (p_aux_obj_constr != nullptr) {
+    delete p_aux_obj_constr;
+  }
   if (p_aux_obj_var != nullptr) {
     delete p_aux_obj_var;
   }
@@ -50,6 +56,31 @@ std::shared_ptr<detail::IVar> ScipSolver::create_var(
   return std::make_shared<ScipVar>(solver, type, lb, ub, name);
 }
 
+std::shared_ptr<detail::IVar> ScipSolver::create_column(
+  Solver const& solver,
+  Var::Type const& type,
+  std::optional<double> const& lb,
+  std::optional<double> const& ub,
+  double obj,
+  std::vector<Constr> const& constrs,
+  std::vector<double> const& coeffs,
+  std::optional<std::string> const& name
+)
+{
+  for (auto const& constr: constrs)
+    if (static_cast<ScipConstr const&>(*constr.p_impl).p_constr == nullptr)
+      throw std::logic_error("Attempt to add a column to a constraint that was not posted.");
+
+  auto p_var = std::make_shared<ScipVar>(solver, type, lb, ub, name, obj);
+  for (std::size_t i = 0; i < constrs.size(); ++i)
+  {
+    auto p_scip_constr = static_cast<ScipConstr const&>(*constrs[i].p_impl).p_constr;
+    SCIP_CALL_EXC(SCIPaddCoefLinear(p_env, p_scip_constr, p_var->p_var, coeffs[i]));
+  }
+  m_objective_coeffs.record(p_var, obj);
+  return p_var;
+}
+
 std::shared_ptr<detail::IConstr> ScipSolver::create_constr(
   Constr::Type const& type, Expr const& e, std::optional<std::string> const& name
 )
@@ -66,6 +97,37 @@ std::shared_ptr<detail::IIndicatorConstr> ScipSolver::create_indicator_constr(
   return std::make_shared<ScipIndicatorConstr>(implicant, implicand, name);
 }
 
+std::shared_ptr<detail::ISOSConstr> ScipSolver::create_sos_constr(
+  SOSConstr::Type const& type,
+  std::vector<Var> const& vars,
+  std::vector<double> const& weights,
+  std::optional<std::string> const& name
+)
+{
+  return std::make_shared<ScipSOSConstr>(type, vars, weights, name);
+}
+
+std::shared_ptr<detail::IGenConstr> ScipSolver::create_gen_constr(
+  GenConstr::Type const& type,
+  Var const& resultant,
+  std::vector<Var> const& operands,
+  std::optional<std::string> const& name
+)
+{
+  return std::make_shared<ScipGenConstr>(type, resultant, operands, name);
+}
+
+std::shared_ptr<detail::IPwlConstr> ScipSolver::create_pwl_constr(
+  Var const& x,
+  Var const& y,
+  std::vector<double> const& xs,
+  std::vector<double> const& ys,
+  std::optional<std::string> const& name
+)
+{
+  return detail::create_reformulatable_pwl_constr(x, y, xs, ys, name);
+}
+
 SCIP_CONS* ScipSolver::as_scip_constr(Constr const& constr)
 {
   auto const& e = constr.expr();
@@ -103,6 +165,13 @@ SCIP_CONS* ScipSolver::as_scip_constr(Constr const& constr)
     [](auto const& v) { return static_cast<ScipVar const&>(*v.p_impl).p_var; }
   );
 
+  double lhs = -SCIPinfinity(p_env);
+  if (type == Constr::Equal)
+    lhs = -e.constant();
+  else
+  if (type == Constr::Range)
+    lhs = -constr.width() - e.constant();
+
   SCIP_CONS* p_constr;
 
   if (e.is_linear())
@@ -114,7 +183,7 @@ SCIP_CONS* ScipSolver::as_scip_constr(Constr const& constr)
       linear_coeffs.size(),
       scip_linear_vars.data(),
       linear_coeffs.data(),
-      (type == Constr::Equal) ? -e.constant() : -SCIPinfinity(p_env),
+      lhs,
       -e.constant()
     ));
   }
@@ -131,7 +200,7 @@ SCIP_CONS* ScipSolver::as_scip_constr(Constr const& constr)
       scip_quad_vars_1.data(),
       scip_quad_vars_2.data(),
       quad_coeffs.data(),
-      (type == Constr::Equal) ? -e.constant() : -SCIPinfinity(p_env),
+      lhs,
       -e.constant()
     ));
   }
@@ -145,34 +214,84 @@ SCIP_CONS* ScipSolver::as_scip_constr(Constr const& constr)
 
 void ScipSolver::set_objective(Solver::Sense const& sense, Expr const& e)
 {
+  if(SCIPgetStage(p_env) == SCIP_STAGE_SOLVED)
+    setup_reoptimization();
+
+  SCIP_OBJSENSE scip_sense = sense == Solver::Sense::Maximize
+    ? SCIP_OBJSENSE_MAXIMIZE
+    : SCIP_OBJSENSE_MINIMIZE;
+
+  // SCIP does not support non-linear objective functions directly: the
+  // quadratic terms q of e (and its constant) are moved to a constraint
+  // q == aux, aux taking their place. The auxiliary variable is reused,
+  // and so is the constraint as long as q does not change, the linear
+  // terms then being posted as objective coefficients; replacing the
+  // constraint goes back to the problem stage.
+  Expr posted;
   if (e.is_linear())
   {
-    auto vars = e.linear_vars();
-    auto coeffs = e.linear_coeffs();
-    for (std::size_t i = 0; i < vars.size(); ++i)
-    {
-      auto p_scip_var = static_cast<ScipVar const&>(*vars[i].p_impl).p_var;
-      SCIP_CALL_EXC(SCIPchgVarObj(p_env, p_scip_var, coeffs[i]));
-    }
+    posted = e;
+    remove_aux_obj_constr();
   }
   else
-  if (e.is_quadratic())
   {
-    // SCIP does not support non-linear objective functions directly. 
-    // Reformulation using an auxilliary variable and a non-linear constraint:
+    Expr q = e.constant();
+    auto quad_vars_1 = e.quad_vars_1();
+    auto quad_vars_2 = e.quad_vars_2();
+    auto quad_coeffs = e.quad_coeffs();
+    for (std::size_t i = 0; i < quad_coeffs.size(); ++i)
+      q += quad_coeffs[i] * quad_vars_1[i] * quad_vars_2[i];
+
+    if (p_aux_obj_var == nullptr)
+      p_aux_obj_var = new Var(e.solver(), Var::Type::Continuous);
+    if (
+      p_aux_obj_constr == nullptr or
+      !(p_aux_obj_constr->expr() - (q - *p_aux_obj_var)).is_zero()
+    )
+    {
+      remove_aux_obj_constr();
+      p_aux_obj_constr = new Constr(q == *p_aux_obj_var);
+      add(*p_aux_obj_constr);
+    }
 
-    p_aux_obj_var = new Var(e.solver(), Var::Type::Continuous);
-    add(e == *p_aux_obj_var);
+    auto linear_vars = e.linear_vars();
+    auto linear_coeffs = e.linear_coeffs();
+    for (std::size_t i = 0; i < linear_vars.size(); ++i)
+      posted += linear_coeffs[i] * linear_vars[i];
+    posted += *p_aux_obj_var;
+  }
 
-    auto p_scip_var = static_cast<ScipVar const&>(*p_aux_obj_var->p_impl).p_var;
-    SCIP_CALL_EXC(SCIPchgVarObj(p_env, p_scip_var, 1));
+  // with reoptimization the objective is changed as a whole, the
+  // coefficients of the other variables being reset.
+  if (m_reoptimizing)
+  {
+    std::vector<SCIP_VAR*> p_scip_vars;
+    for (auto const& v: posted.linear_vars())
+      p_scip_vars.push_back(static_cast<ScipVar const&>(*v.p_impl).p_var);
+    auto coeffs = posted.linear_coeffs();
+    SCIP_CALL_EXC(SCIPchgReoptObjective(
+      p_env, scip_sense, p_scip_vars.data(), coeffs.data(), p_scip_vars.size()
+    ));
+    m_objective_coeffs.reset(posted);
+    return;
   }
-  else
-    assert(false);
 
-	SCIP_OBJSENSE scip_sense = sense == Solver::Sense::Maximize
-    ? SCIP_OBJSENSE_MAXIMIZE
-    : SCIP_OBJSENSE_MINIMIZE;
+  // only the coefficients that changed are posted, all of them being
+  // reset first if these are unknown.
+  auto changes = m_objective_coeffs.update(posted);
+  if (!changes.has_value())
+  {
+    auto p_scip_vars = SCIPgetOrigVars(p_env);
+    for (int i = 0; i < SCIPgetNOrigVars(p_env); ++i)
+      SCIP_CALL_EXC(SCIPchgVarObj(p_env, p_scip_vars[i], 0));
+    m_objective_coeffs.reset(Expr());
+    changes = m_objective_coeffs.update(posted);
+  }
+  for (auto const& [p_var, coeff]: changes.value())
+  {
+    auto p_scip_var = static_cast<ScipVar const&>(*p_var).p_var;
+    SCIP_CALL_EXC(SCIPchgVarObj(p_env, p_scip_var, coeff));
+  }
 
   SCIP_CALL_EXC(SCIPsetObjsense(p_env, scip_sense));
 }
@@ -229,6 +348,10 @@ bool ScipSolver::supports_indicator_constraint(IndicatorConstr const& constr) co
   if (implicant.type() != Constr::Equal)
     return false;
 
+  // Scip indicator constraints cannot express a two-sided implicand.
+  if (implicand.type() == Constr::Range)
+    return false;
+
   // Scip indicator constraints require a linear implicant.
   if (!implicant.expr().is_linear())
     return false;
@@ -356,18 +479,268 @@ void ScipSolver::add(IndicatorConstr const& constr)
   }
 }
 
-void ScipSolver::remove(Constr const& constr)
+bool ScipSolver::supports_sos_constraint(SOSConstr const&) const
 {
+  // SOS constraints are not added as lazy constraints.
+  return !is_in_callback();
+}
+
+void ScipSolver::add(SOSConstr const& constr)
+{
+  auto const& constr_impl = static_cast<ScipSOSConstr const&>(*constr.p_impl);
+
+  if (constr_impl.p_constr != nullptr)
+  {
+    throw std::logic_error("Attempt to post the same constraint twice.");
+  }
+
+  if (!supports_sos_constraint(constr))
+    throw std::logic_error(
+      "Scip does not support adding SOS constraints during solving. Try .reformulation()."
+    );
+
   if(SCIPgetStage(p_env) == SCIP_STAGE_SOLVED)
-    SCIP_CALL_EXC(SCIPfreeTransform(p_env));
+    setup_reoptimization();
+
+  std::vector<SCIP_VAR*> scip_vars;
+  std::transform(
+    constr.vars().begin(),
+    constr.vars().end(),
+    std::back_inserter(scip_vars),
+    [](auto const& v) { return static_cast<ScipVar const&>(*v.p_impl).p_var; }
+  );
+  std::vector<double> weights = constr.weights();
+
+  auto const& name = constr.name();
+  SCIP_CONS* p_constr;
+  if (constr.type() == SOSConstr::SOS1)
+  {
+    SCIP_CALL_EXC(SCIPcreateConsBasicSOS1(
+      p_env,
+      &p_constr,
+      name.value_or("").c_str(),
+      scip_vars.size(),
+      scip_vars.data(),
+      weights.data()
+    ));
+  }
+  else
+  {
+    SCIP_CALL_EXC(SCIPcreateConsBasicSOS2(
+      p_env,
+      &p_constr,
+      name.value_or("").c_str(),
+      scip_vars.size(),
+      scip_vars.data(),
+      weights.data()
+    ));
+  }
+
+  SCIP_CALL_EXC(SCIPaddCons(p_env, p_constr));
+
+  constr_impl.p_constr = p_constr;
+}
+
+bool ScipSolver::supports_gen_constraint(GenConstr const& constr) const
+{
+  // Scip has dedicated handlers for and/or constraints only.
+  if (constr.type() != GenConstr::And and constr.type() != GenConstr::Or)
+    return false;
+  return !is_in_callback();
+}
+
+void ScipSolver::add(GenConstr const& constr)
+{
+  auto const& constr_impl = static_cast<ScipGenConstr const&>(*constr.p_impl);
+
+  if (constr_impl.p_constr != nullptr)
+  {
+    throw std::logic_error("Attempt to post the same constraint twice.");
+  }
+
+  if (!supports_gen_constraint(constr))
+    throw std::logic_error(
+      "Scip does not support this general constraint. Try .reformulation()."
+    );
+
+  if(SCIPgetStage(p_env) == SCIP_STAGE_SOLVED)
+    setup_reoptimization();
+
+  auto as_scip_var = [](Var const& v) {
+    return static_cast<ScipVar const&>(*v.p_impl).p_var;
+  };
+
+  std::vector<SCIP_VAR*> scip_operands;
+  std::transform(
+    constr.operands().begin(),
+    constr.operands().end(),
+    std::back_inserter(scip_operands),
+    as_scip_var
+  );
+
+  auto const& name = constr.name();
+  SCIP_CONS* p_constr;
+  if (constr.type() == GenConstr::And)
+  {
+    SCIP_CALL_EXC(SCIPcreateConsBasicAnd(
+      p_env,
+      &p_constr,
+      name.value_or("").c_str(),
+      as_scip_var(constr.resultant()),
+      scip_operands.size(),
+      scip_operands.data()
+    ));
+  }
+  else
+  {
+    assert(constr.type() == GenConstr::Or);
+    SCIP_CALL_EXC(SCIPcreateConsBasicOr(
+      p_env,
+      &p_constr,
+      name.value_or("").c_str(),
+      as_scip_var(constr.resultant()),
+      scip_operands.size(),
+      scip_operands.data()
+    ));
+  }
+
+  SCIP_CALL_EXC(SCIPaddCons(p_env, p_constr));
+
+  constr_impl.p_constr = p_constr;
+}
+
+bool ScipSolver::supports_pwl_constraint(PwlConstr const&) const
+{
+  return false;
+}
+
+void ScipSolver::add(PwlConstr const&)
+{
+  throw std::logic_error("Scip does not support piecewise linear constraints.");
+}
+
+void ScipSolver::remove(Constr const& constr)
+{
+  free_transform();
  
   auto p_scip_constr = static_cast<ScipConstr const&>(*constr.p_impl).p_constr;
   SCIP_CALL_EXC(SCIPdelCons(p_env, p_scip_constr));
 }
 
+void ScipSolver::remove_constrs(std::vector<Constr> const& constrs)
+{
+  // a single return to the problem stage for all of them.
+  free_transform();
+
+  for (auto const& constr: constrs)
+  {
+    auto p_scip_constr = static_cast<ScipConstr const&>(*constr.p_impl).p_constr;
+    SCIP_CALL_EXC(SCIPdelCons(p_env, p_scip_constr));
+  }
+}
+
+void ScipSolver::set_coeff(Constr const& constr, Var const& var, double coeff)
+{
+  if (!constr.expr().is_linear())
+    throw std::logic_error("SCIP does not support changing coefficients of quadratic constraints.");
+
+  auto p_scip_constr = static_cast<ScipConstr const&>(*constr.p_impl).p_constr;
+  if (p_scip_constr == nullptr)
+    throw std::logic_error("Attempt to modify a constraint that was not posted.");
+
+  free_transform();
+
+  auto p_scip_var = static_cast<ScipVar const&>(*var.p_impl).p_var;
+  SCIP_CALL_EXC(SCIPchgCoefLinear(p_env, p_scip_constr, p_scip_var, coeff));
+}
+
+void ScipSolver::set_rhs(Constr const& constr, double rhs)
+{
+  auto p_scip_constr = static_cast<ScipConstr const&>(*constr.p_impl).p_constr;
+  if (p_scip_constr == nullptr)
+    throw std::logic_error("Attempt to modify a constraint that was not posted.");
+
+  free_transform();
+
+  auto const is_linear = constr.expr().is_linear();
+  auto const chg_lhs = [&](double value) {
+    if (is_linear)
+    {
+      SCIP_CALL_EXC(SCIPchgLhsLinear(p_env, p_scip_constr, value));
+    }
+    else
+    {
+      SCIP_CALL_EXC(SCIPchgLhsNonlinear(p_env, p_scip_constr, value));
+    }
+  };
+  auto const chg_rhs = [&](double value) {
+    if (is_linear)
+    {
+      SCIP_CALL_EXC(SCIPchgRhsLinear(p_env, p_scip_constr, value));
+    }
+    else
+    {
+      SCIP_CALL_EXC(SCIPchgRhsNonlinear(p_env, p_scip_constr, value));
+    }
+  };
+
+  if (constr.type() == Constr::LessEqual)
+  {
+    chg_rhs(rhs);
+    return;
+  }
+
+  // the sides are moved in an order keeping lhs <= rhs.
+  double const lhs = rhs - constr.width();
+  if (rhs >= -constr.expr().constant())
+  {
+    chg_rhs(rhs);
+    chg_lhs(lhs);
+  }
+  else
+  {
+    chg_lhs(lhs);
+    chg_rhs(rhs);
+  }
+}
+
+// SCIP reports the dual values of the constraints of the transformed
+// problem: they are meaningful for continuous problems solved without
+// presolving.
+std::vector<double> ScipSolver::get_duals(std::vector<Constr> const& constrs) const
+{
+  std::vector<double> r;
+  for (auto const& constr: constrs)
+  {
+    auto p_scip_constr = static_cast<ScipConstr const&>(*constr.p_impl).p_constr;
+    if (p_scip_constr == nullptr)
+      throw std::logic_error("Attempt to query a constraint that was not posted.");
+    double dual;
+    SCIP_Bool is_bound_constraint;
+    SCIP_CALL_EXC(SCIPgetDualSolVal(p_env, p_scip_constr, &dual, &is_bound_constraint));
+    r.push_back(dual);
+  }
+  return r;
+}
+
+// Reduced costs of the root relaxation, the transformed problem being a
+// minimization: as the duals, they refer to the presolved problem.
+std::vector<double> ScipSolver::get_reduced_costs(std::vector<Var> const& vars) const
+{
+  double const sign = get_objective_sense() == Solver::Sense::Maximize ? -1 : 1;
+  std::vector<double> r;
+  for (auto const& v: vars)
+  {
+    auto p_trans_var = SCIPvarGetTransVar(static_cast<ScipVar const&>(*v.p_impl).p_var);
+    r.push_back(p_trans_var == nullptr ? 0 : sign * SCIPvarGetBestRootRedcost(p_trans_var));
+  }
+  return r;
+}
+
 std::pair<Solver::Result, bool> ScipSolver::solve()
 {
   SCIP_CALL_EXC(SCIPsolve(p_env));
+  m_has_reopt_data = m_reoptimizing;
 
   bool has_solution = SCIPgetNBestSolsFound(p_env) > 0;
 
@@ -460,6 +833,86 @@ double ScipSolver::get_epsilon() const
   return v;
 }
 
+// Semi-continuous variables keep the bound disjunction excluding the
+// values between zero and their bounds, semi-integer ones being integer.
+void ScipSolver::relax_integrality(bool fix_integers)
+{
+  if (fix_integers and p_sol == nullptr)
+    throw std::logic_error("Attempt to fix integers without a solution.");
+
+  // values are read before freeing the transformed problem.
+  int const nr_vars = SCIPgetNOrigVars(p_env);
+  SCIP_VAR** p_vars = SCIPgetOrigVars(p_env);
+  std::vector<double> values;
+  if (fix_integers)
+    for (int i = 0; i < nr_vars; ++i)
+      values.push_back(SCIPgetSolVal(p_env, p_sol, p_vars[i]));
+
+  free_transform();
+
+  restore_integrality();
+  for (int i = 0; i < nr_vars; ++i)
+  {
+    auto p_var = p_vars[i];
+    auto const type = SCIPvarGetType(p_var);
+    if (type == SCIP_VARTYPE_CONTINUOUS)
+      continue;
+    double const lb = SCIPvarGetLbOriginal(p_var);
+    double const ub = SCIPvarGetUbOriginal(p_var);
+    m_relaxed_vars.push_back({p_var, type, lb, ub});
+
+    auto const [new_lb, new_ub] = detail::relaxed_bounds(
+      true, false, lb, ub,
+      fix_integers ? std::optional<double>(values[i]) : std::nullopt,
+      get_feasibility_tolerance()
+    );
+    SCIP_Bool infeasible;
+    SCIP_CALL_EXC(SCIPchgVarType(p_env, p_var, SCIP_VARTYPE_CONTINUOUS, &infeasible));
+    SCIP_CALL_EXC(SCIPchgVarLb(p_env, p_var, new_lb));
+    SCIP_CALL_EXC(SCIPchgVarUb(p_env, p_var, new_ub));
+  }
+  std::sort(
+    m_relaxed_vars.begin(), m_relaxed_vars.end(),
+    [](auto const& v1, auto const& v2) { return std::less<SCIP_VAR*>()(v1.p_var, v2.p_var); }
+  );
+}
+
+void ScipSolver::restore_integrality()
+{
+  if (m_relaxed_vars.empty())
+    return;
+
+  free_transform();
+
+  for (auto const& relaxed_var: m_relaxed_vars)
+  {
+    SCIP_Bool infeasible;
+    SCIP_CALL_EXC(SCIPchgVarType(p_env, relaxed_var.p_var, relaxed_var.type, &infeasible));
+    SCIP_CALL_EXC(SCIPchgVarLb(p_env, relaxed_var.p_var, relaxed_var.lb));
+    SCIP_CALL_EXC(SCIPchgVarUb(p_env, relaxed_var.p_var, relaxed_var.ub));
+  }
+  m_relaxed_vars.clear();
+}
+
+std::optional<detail::ISolver::DeclaredDomain> ScipSolver::declared_domain(
+  detail::IVar const& var
+) const
+{
+  auto const& scip_var = static_cast<ScipVar const&>(var);
+  // semi-continuous variables keep their own type and bounds.
+  if (m_relaxed_vars.empty() or scip_var.m_semi_type.has_value())
+    return std::nullopt;
+  auto it = std::lower_bound(
+    m_relaxed_vars.begin(), m_relaxed_vars.end(), scip_var.p_var,
+    [](auto const& relaxed_var, SCIP_VAR* p_var) {
+      return std::less<SCIP_VAR*>()(relaxed_var.p_var, p_var);
+    }
+  );
+  if (it == m_relaxed_vars.end() or it->p_var != scip_var.p_var)
+    return std::nullopt;
+  return DeclaredDomain{scip_var_type(it->type), it->lb, it->ub};
+}
+
 double ScipSolver::infinity() const
 {
   return SCIPinfinity(p_env);
@@ -470,6 +923,14 @@ void ScipSolver::set_time_limit(double secs)
   SCIP_CALL_EXC(SCIPsetRealParam(p_env, "limits/time", secs));
 }
 
+void ScipSolver::interrupt()
+{
+  // SCIP only accepts interruptions while presolving and solving.
+  auto const stage = SCIPgetStage(p_env);
+  if (stage == SCIP_STAGE_PRESOLVING or stage == SCIP_STAGE_SOLVING)
+    SCIP_CALL_EXC(SCIPinterruptSolve(p_env));
+}
+
 void ScipSolver::dump(std::string const& filename) const
 {
   SCIP_CALL_EXC(SCIPwriteOrigProblem(p_env, filename.c_str(), NULL, false));	
@@ -500,12 +961,161 @@ void ScipSolver::set_warm_start(PartialSolution const& partial_solution)
 void ScipSolver::set_reoptimizing(bool value)
 {
   SCIP_CALL_EXC(SCIPenableReoptimization(p_env, value)); 
+  m_reoptimizing = value;
 }	
 
+// Reoptimization keeps the search tree of the last solve, which remains
+// valid when the objective changes or the feasible region is restricted.
+// The transformed problem is kept as well, the changes requiring the
+// problem stage dropping the search tree (see free_transform).
 void ScipSolver::setup_reoptimization()
 {
-  //SCIP_CALL_EXC(SCIPfreeReoptSolve(p_env));
-  SCIP_CALL_EXC(SCIPfreeTransform(p_env));
+  if (m_reoptimizing)
+  {
+    SCIP_CALL_EXC(SCIPfreeReoptSolve(p_env));
+  }
+  else
+  {
+    SCIP_CALL_EXC(SCIPfreeTransform(p_env));
+  }
+}
+
+std::shared_ptr<detail::ISolver> ScipSolver::clone() const
+{
+  if (is_in_callback())
+    throw std::logic_error("Operation not allowed within callback.");
+
+  // SCIPcopyOrig includes the plugins and creates the problem itself.
+  auto p_clone = std::make_shared<ScipSolver>(false);
+  SCIP_CALL_EXC(SCIPfree(&p_clone->p_env));
+  SCIP_CALL_EXC(SCIPcreate(&p_clone->p_env));
+
+  SCIP_HASHMAP* p_var_map;
+  SCIP_HASHMAP* p_constr_map;
+  SCIP_CALL_EXC(SCIPhashmapCreate(
+    &p_var_map, SCIPblkmem(p_clone->p_env), SCIPgetNOrigVars(p_env)
+  ));
+  SCIP_CALL_EXC(SCIPhashmapCreate(
+    &p_constr_map, SCIPblkmem(p_clone->p_env), SCIPgetNOrigConss(p_env)
+  ));
+
+  SCIP_Bool valid;
+  SCIP_CALL_EXC(SCIPcopyOrig(
+    p_env, p_clone->p_env, p_var_map, p_constr_map, "", false, false, true, &valid
+  ));
+
+  // the lazy constraint handlers (which are not copied) lack a copy
+  // callback, hence invalidate the copy of a problem copied in full.
+  bool is_copied = true;
+  auto p_scip_vars = SCIPgetOrigVars(p_env);
+  for (int i = 0; i < SCIPgetNOrigVars(p_env); ++i)
+  {
+    auto p_copy = static_cast<SCIP_VAR*>(SCIPhashmapGetImage(p_var_map, p_scip_vars[i]));
+    p_clone->m_source_vars[p_scip_vars[i]] = p_copy;
+    is_copied = is_copied and p_copy != nullptr;
+  }
+  auto p_scip_constrs = SCIPgetOrigConss(p_env);
+  for (int i = 0; i < SCIPgetNOrigConss(p_env); ++i)
+  {
+    auto p_copy = static_cast<SCIP_CONS*>(SCIPhashmapGetImage(p_constr_map, p_scip_constrs[i]));
+    p_clone->m_source_constrs[p_scip_constrs[i]] = p_copy;
+    is_copied = is_copied and p_copy != nullptr;
+  }
+  // the copy is relaxed as the source, until it restores integrality.
+  for (auto const& relaxed_var: m_relaxed_vars)
+  {
+    auto p_copy = static_cast<SCIP_VAR*>(SCIPhashmapGetImage(p_var_map, relaxed_var.p_var));
+    if (p_copy != nullptr)
+      p_clone->m_relaxed_vars.push_back({p_copy, relaxed_var.type, relaxed_var.lb, relaxed_var.ub});
+  }
+  std::sort(
+    p_clone->m_relaxed_vars.begin(), p_clone->m_relaxed_vars.end(),
+    [](auto const& v1, auto const& v2) { return std::less<SCIP_VAR*>()(v1.p_var, v2.p_var); }
+  );
+  SCIPhashmapFree(&p_constr_map);
+  SCIPhashmapFree(&p_var_map);
+
+  if (!valid and !is_copied)
+    throw std::logic_error("SCIP could not copy the problem.");
+
+  if (m_reoptimizing)
+    p_clone->set_reoptimizing(true);
+  if (p_aux_obj_var != nullptr)
+    p_clone->m_source_aux_obj_var = *p_aux_obj_var;
+  if (p_aux_obj_constr != nullptr)
+    p_clone->m_source_aux_obj_constr = *p_aux_obj_constr;
+  p_clone->m_objective_coeffs.invalidate();
+  return p_clone;
+}
+
+std::shared_ptr<detail::IVar> ScipSolver::clone_var(
+  Solver const& solver, detail::IVar const& var
+) const
+{
+  auto const& scip_var = static_cast<ScipVar const&>(var);
+  auto it = m_source_vars.find(scip_var.p_var);
+  if (it == m_source_vars.end() or it->second == nullptr)
+    return nullptr;
+
+  SCIP_CONS* p_semi_constr = nullptr;
+  if (scip_var.p_semi_constr != nullptr)
+    p_semi_constr = m_source_constrs.at(scip_var.p_semi_constr);
+  return std::make_shared<ScipVar>(solver, scip_var, it->second, p_semi_constr);
+}
+
+bool ScipSolver::bind_cloned_constr(Constr const& constr, Constr const& copy)
+{
+  auto p_scip_constr = static_cast<ScipConstr const&>(*constr.p_impl).p_constr;
+  auto it = m_source_constrs.find(p_scip_constr);
+  if (p_scip_constr == nullptr or it == m_source_constrs.end() or it->second == nullptr)
+    return false;
+
+  SCIP_CALL_EXC(SCIPcaptureCons(p_env, it->second));
+  static_cast<ScipConstr const&>(*copy.p_impl).p_constr = it->second;
+  return true;
+}
+
+void ScipSolver::finish_clone(Solver::Remapping const& remapping)
+{
+  if (m_source_aux_obj_var.has_value())
+    p_aux_obj_var = new Var(remapping.var(m_source_aux_obj_var.value()));
+  // the objective constraint is internal, hence not among the remapped
+  // ones: its copy is bound here.
+  if (m_source_aux_obj_constr.has_value())
+  {
+    auto const& constr = m_source_aux_obj_constr.value();
+    Constr copy(p_aux_obj_var->solver(), constr.type(), remapping.expr(constr.expr()));
+    if (bind_cloned_constr(constr, copy))
+      p_aux_obj_constr = new Constr(copy);
+  }
+
+  m_source_vars.clear();
+  m_source_constrs.clear();
+  m_source_aux_obj_var.reset();
+  m_source_aux_obj_constr.reset();
+}
+
+void ScipSolver::remove_aux_obj_constr()
+{
+  if (p_aux_obj_constr == nullptr)
+    return;
+  remove(*p_aux_obj_constr);
+  delete p_aux_obj_constr;
+  p_aux_obj_constr = nullptr;
+}
+
+void ScipSolver::free_transform()
+{
+  if(SCIPgetStage(p_env) != SCIP_STAGE_PROBLEM)
+    SCIP_CALL_EXC(SCIPfreeTransform(p_env));
+
+  // the stored search tree could cut off solutions of the changed problem.
+  if (m_reoptimizing and m_has_reopt_data)
+  {
+    SCIP_CALL_EXC(SCIPenableReoptimization(p_env, false));
+    SCIP_CALL_EXC(SCIPenableReoptimization(p_env, true));
+  }
+  m_has_reopt_data = false;
 }
 
 namespace detail {
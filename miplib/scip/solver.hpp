@@ -1,6 +1,7 @@
 #pragma once
 
 #include <miplib/solver.hpp>
+#include <miplib/util/objective.hpp>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -43,6 +44,17 @@ struct ScipSolver : detail::ISolver
     std::optional<std::string> const& name
   );
 
+  std::shared_ptr<detail::IVar> create_column(
+    Solver const& solver,
+    Var::Type const& type,
+    std::optional<double> const& lb,
+    std::optional<double> const& ub,
+    double obj,
+    std::vector<Constr> const& constrs,
+    std::vector<double> const& coeffs,
+    std::optional<std::string> const& name
+  );
+
   std::shared_ptr<detail::IConstr> create_constr(
     Constr::Type const& type, Expr const& e, std::optional<std::string> const& name
   );
@@ -53,19 +65,55 @@ struct ScipSolver : detail::ISolver
     std::optional<std::string> const& name
   );
 
+  std::shared_ptr<detail::ISOSConstr> create_sos_constr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name
+  );
+
+  std::shared_ptr<detail::IGenConstr> create_gen_constr(
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name
+  );
+
+  std::shared_ptr<detail::IPwlConstr> create_pwl_constr(
+    Var const& x,
+    Var const& y,
+    std::vector<double> const& xs,
+    std::vector<double> const& ys,
+    std::optional<std::string> const& name
+  );
+
   void set_objective(Solver::Sense const& sense, Expr const& e);
   double get_objective_value() const;
   Solver::Sense get_objective_sense() const;
 
   void add(Constr const& constr);
   void add(IndicatorConstr const& constr);
+  void add(SOSConstr const& constr);
+  void add(GenConstr const& constr);
+  void add(PwlConstr const& constr);
 
   void remove(Constr const& constr);
+  void remove_constrs(std::vector<Constr> const& constrs);
+
+  void set_coeff(Constr const& constr, Var const& var, double coeff);
+  void set_rhs(Constr const& constr, double rhs);
+
+  std::vector<double> get_duals(std::vector<Constr> const& constrs) const;
+  std::vector<double> get_reduced_costs(std::vector<Var> const& vars) const;
   
   void add_lazy_constr_handler(LazyConstrHandler const& constr, bool at_integral_nodes_only);
 
   std::pair<Solver::Result, bool> solve();
 
+  void relax_integrality(bool fix_integers);
+  void restore_integrality();
+  std::optional<DeclaredDomain> declared_domain(detail::IVar const& var) const;
+
   void set_non_convex_policy(Solver::NonConvexPolicy policy);
   void set_int_feasibility_tolerance(double value);
   void set_feasibility_tolerance(double value);
@@ -81,6 +129,9 @@ struct ScipSolver : detail::ISolver
   SCIP_CONS* as_scip_constr(Constr const& constr);
 
   bool supports_indicator_constraint(IndicatorConstr const& constr) const;
+  bool supports_sos_constraint(SOSConstr const& constr) const;
+  bool supports_gen_constraint(GenConstr const& constr) const;
+  bool supports_pwl_constraint(PwlConstr const& constr) const;
 
   bool supports_quadratic_constraints() const { return true; }
   bool supports_quadratic_objective() const { return true; }
@@ -90,6 +141,7 @@ struct ScipSolver : detail::ISolver
   void dump(std::string const& filename) const;
 
   void set_time_limit(double secs);
+  void interrupt();
 
   bool is_in_callback() const;
 
@@ -98,6 +150,19 @@ struct ScipSolver : detail::ISolver
   void set_reoptimizing(bool);
   void setup_reoptimization();
 
+  std::shared_ptr<detail::ISolver> clone() const;
+  std::shared_ptr<detail::IVar> clone_var(Solver const& solver, detail::IVar const& var) const;
+  bool bind_cloned_constr(Constr const& constr, Constr const& copy);
+  void finish_clone(Solver::Remapping const& remapping);
+
+  // Back to the problem stage for changes reoptimization cannot follow
+  // (e.g. enlarging the feasible region), dropping the reoptimization data.
+  void free_transform();
+
+  // removes the constraint defining the auxiliary objective variable,
+  // if a quadratic objective was posted.
+  void remove_aux_obj_constr();
+
   static std::string backend_info();
 
   static bool is_available();
@@ -105,7 +170,24 @@ struct ScipSolver : detail::ISolver
   SCIP* p_env;
   SCIP_SOL* p_sol;
   Var* p_aux_obj_var;
+  Constr* p_aux_obj_constr;
+  detail::ObjectiveCoefficients m_objective_coeffs;
+
+  // in a copy, the copies of the variables and constraints of the source
+  // problem, and its objective variable and constraint until remapped.
+  std::map<SCIP_VAR*, SCIP_VAR*> m_source_vars;
+  std::map<SCIP_CONS*, SCIP_CONS*> m_source_constrs;
+  std::optional<Var> m_source_aux_obj_var;
+  std::optional<Constr> m_source_aux_obj_constr;
+  bool m_reoptimizing = false;
+  // if the last solve stored a search tree for reoptimization.
+  bool m_has_reopt_data = false;
   std::unique_ptr<detail::ScipCurrentStateHandle> p_current_state_handler;
+
+  // variables relaxed by relax_integrality (sorted by address) along with
+  // their type and bounds.
+  struct RelaxedVar { SCIP_VAR* p_var; SCIP_VARTYPE type; double lb; double ub; };
+  std::vector<RelaxedVar> m_relaxed_vars;
 };
 
 }  // namespace miplib
@@ -2,6 +2,8 @@
 
 #include <miplib/scip/util.hpp>
 
+#include <algorithm>
+
 namespace miplib {
 
 ScipVar::ScipVar(
@@ -9,10 +11,12 @@ ScipVar::ScipVar(
   Var::Type const& type,
   std::optional<double> const& lb,
   std::optional<double> const& ub,
-  std::optional<std::string> const& name
+  std::optional<std::string> const& name,
+  double obj
 ):
   m_solver(solver),
-  p_var(nullptr)
+  p_var(nullptr),
+  p_semi_constr(nullptr)
 {
   auto p_env = static_cast<ScipSolver const&>(*m_solver.p_impl).p_env;
 
@@ -41,6 +45,16 @@ ScipVar::ScipVar(
     scip_lb = lb.value_or(-SCIPinfinity(p_env));
     scip_ub = ub.value_or(SCIPinfinity(p_env));
   }
+  else if (type == Var::Type::SemiContinuous or type == Var::Type::SemiInteger)
+  {
+    scip_var_type = (type == Var::Type::SemiContinuous) ?
+      SCIP_VARTYPE_CONTINUOUS : SCIP_VARTYPE_INTEGER;
+    m_semi_type = type;
+    m_semi_lb = lb.value_or(0);
+    m_semi_ub = ub.value_or(SCIPinfinity(p_env));
+    scip_lb = std::min(m_semi_lb, 0.0);
+    scip_ub = std::max(m_semi_ub, 0.0);
+  }
   else
   {
     throw std::logic_error("SCIP does not support this variable type");
@@ -52,17 +66,65 @@ ScipVar::ScipVar(
     name.has_value() ? name.value().c_str() : NULL,
     scip_lb,
     scip_ub,
-    0.0,  // obj
+    obj,
     scip_var_type
   ));
 
+  // variables can only be added to the original problem.
+  static_cast<ScipSolver&>(*m_solver.p_impl).free_transform();
+
   // add the SCIP_VAR object to the scip problem
   SCIP_CALL_EXC(SCIPaddVar(p_env, p_var));
+
+  // x <= 0 \/ x >= lb (resp. x >= 0 \/ x <= ub) if zero is below
+  // (resp. above) the semi-continuous domain.
+  if (m_semi_type.has_value() and (m_semi_lb > 0 or m_semi_ub < 0))
+  {
+    SCIP_VAR* vars[] = {p_var, p_var};
+    SCIP_BOUNDTYPE bound_types[2];
+    SCIP_Real bounds[2];
+    if (m_semi_lb > 0)
+    {
+      bound_types[0] = SCIP_BOUNDTYPE_UPPER;
+      bounds[0] = 0;
+      bound_types[1] = SCIP_BOUNDTYPE_LOWER;
+      bounds[1] = m_semi_lb;
+    }
+    else
+    {
+      bound_types[0] = SCIP_BOUNDTYPE_LOWER;
+      bounds[0] = 0;
+      bound_types[1] = SCIP_BOUNDTYPE_UPPER;
+      bounds[1] = m_semi_ub;
+    }
+    SCIP_CALL_EXC(SCIPcreateConsBasicBounddisjunction(
+      p_env, &p_semi_constr, "", 2, vars, bound_types, bounds
+    ));
+    SCIP_CALL_EXC(SCIPaddCons(p_env, p_semi_constr));
+  }
+}
+
+ScipVar::ScipVar(
+  Solver const& solver, ScipVar const& var, SCIP_VAR* p_var, SCIP_CONS* p_semi_constr
+):
+  m_solver(solver),
+  p_var(p_var),
+  m_semi_type(var.m_semi_type),
+  m_semi_lb(var.m_semi_lb),
+  m_semi_ub(var.m_semi_ub),
+  p_semi_constr(p_semi_constr)
+{
+  auto p_env = static_cast<ScipSolver const&>(*m_solver.p_impl).p_env;
+  SCIP_CALL_EXC(SCIPcaptureVar(p_env, p_var));
+  if (p_semi_constr != nullptr)
+    SCIP_CALL_EXC(SCIPcaptureCons(p_env, p_semi_constr));
 }
 
 ScipVar::~ScipVar()
 {
   auto p_env = static_cast<ScipSolver const&>(*m_solver.p_impl).p_env;
+  if (p_semi_constr != nullptr)
+    SCIP_CALL_TERM(SCIPreleaseCons(p_env, &p_semi_constr));
   SCIP_CALL_TERM(SCIPreleaseVar(p_env, &p_var));
 }
 
@@ -85,8 +147,14 @@ double ScipVar::value() const
 
 Var::Type ScipVar::type() const
 {
-  SCIP_VARTYPE scip_type = SCIPvarGetType(p_var);
+  if (m_semi_type.has_value())
+    return m_semi_type.value();
 
+  return scip_var_type(SCIPvarGetType(p_var));
+}
+
+Var::Type scip_var_type(SCIP_VARTYPE scip_type)
+{
   switch (scip_type)
   {
     case SCIP_VARTYPE_CONTINUOUS:
@@ -121,6 +189,8 @@ void ScipVar::set_name(std::string const& new_name)
 
 double ScipVar::lb() const
 {
+  if (m_semi_type.has_value())
+    return m_semi_lb;
   if (type() == Var::Type::Binary)
     return 0;
   return SCIPvarGetLbOriginal(p_var)	;
@@ -128,6 +198,8 @@ double ScipVar::lb() const
 
 double ScipVar::ub() const
 {
+  if (m_semi_type.has_value())
+    return m_semi_ub;
   if (type() == Var::Type::Binary)
     return 1;
   return SCIPvarGetUbOriginal(p_var)	;
@@ -140,6 +212,15 @@ void ScipVar::set_lb(double new_lb)
   if (scip_solver.is_in_callback())
     throw std::logic_error("Can't modify this attribute from a callback.");
 
+  if (m_semi_type.has_value())
+    throw std::logic_error("SCIP does not support changing bounds of semi-continuous variables.");
+
+  // tightening the bound keeps the reoptimization data.
+  if (new_lb < lb())
+    static_cast<ScipSolver&>(*m_solver.p_impl).free_transform();
+  else if (SCIPgetStage(scip_solver.p_env) == SCIP_STAGE_SOLVED)
+    static_cast<ScipSolver&>(*m_solver.p_impl).setup_reoptimization();
+
   auto p_env = scip_solver.p_env;
   SCIPchgVarLb(p_env, p_var, new_lb);
 }
@@ -151,7 +232,16 @@ void ScipVar::set_ub(double new_ub)
   if (scip_solver.is_in_callback())
     throw std::logic_error("Can't modify this attribute from a callback.");
 
-  auto p_env = static_cast<ScipSolver const&>(*m_solver.p_impl).p_env;
+  if (m_semi_type.has_value())
+    throw std::logic_error("SCIP does not support changing bounds of semi-continuous variables.");
+
+  // tightening the bound keeps the reoptimization data.
+  if (new_ub > ub())
+    static_cast<ScipSolver&>(*m_solver.p_impl).free_transform();
+  else if (SCIPgetStage(scip_solver.p_env) == SCIP_STAGE_SOLVED)
+    static_cast<ScipSolver&>(*m_solver.p_impl).setup_reoptimization();
+
+  auto p_env = scip_solver.p_env;
   SCIPchgVarUb(p_env, p_var, new_ub);
 }
 
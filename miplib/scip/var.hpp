@@ -6,6 +6,9 @@
 
 namespace miplib {
 
+// Type of a variable of the given SCIP type.
+Var::Type scip_var_type(SCIP_VARTYPE scip_type);
+
 struct ScipVar : detail::IVar
 {
   ScipVar(
@@ -13,7 +16,15 @@ struct ScipVar : detail::IVar
     Var::Type const& type,
     std::optional<double> const& lb,
     std::optional<double> const& ub,
-    std::optional<std::string> const& name
+    std::optional<std::string> const& name,
+    double obj = 0
+  );
+
+  // Counterpart of var in a copy of its problem, p_var (resp.
+  // p_semi_constr) being the copy of its SCIP variable (resp. of its
+  // bound disjunction).
+  ScipVar(
+    Solver const& solver, ScipVar const& var, SCIP_VAR* p_var, SCIP_CONS* p_semi_constr
   );
 
   virtual ~ScipVar();
@@ -40,6 +51,14 @@ struct ScipVar : detail::IVar
 
   Solver m_solver;
   SCIP_VAR* p_var;
+
+  // SCIP has no semi-continuous variables: these are created with bounds
+  // extended to zero, a bound disjunction excluding the values between
+  // zero and the actual bounds.
+  std::optional<Var::Type> m_semi_type;
+  double m_semi_lb;
+  double m_semi_ub;
+  SCIP_CONS* p_semi_constr;
 };
 
 }  // namespace miplib
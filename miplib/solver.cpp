@@ -1,5 +1,18 @@
 #include "solver.hpp"
 
+#include <miplib/util/linearize.hpp>
+
+#include <spdlog/spdlog.h>
+#include <fmt/ostream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <set>
+
 #ifdef WITH_GUROBI
 #  include "gurobi/solver.hpp"
 #endif
@@ -78,9 +91,93 @@ Solver::Solver(Backend backend, bool verbose): m_backend(backend), m_constraint_
   }
 }
 
+// Products involving binary variables are linearized if asked to or if
+// the backend could not handle them otherwise, and the other products are
+// relaxed under NonConvexPolicy::McCormick. Under NonConvexPolicy::Auto,
+// products are linearized only if that makes e convex. The constraints
+// defining the auxiliary variables are posted. Returns nothing if e is
+// left as is.
+std::optional<Expr> Solver::prepare_quadratic(
+  Expr const& e,
+  bool quadratic_is_supported,
+  std::function<bool(Expr const&)> const& is_convex,
+  std::function<std::string()> const& describe
+)
+{
+  auto const policy = p_impl->m_non_convex_policy;
+  if (
+    !e.is_quadratic() or (
+      policy != NonConvexPolicy::Linearize and
+      policy != NonConvexPolicy::McCormick and
+      policy != NonConvexPolicy::Auto and
+      quadratic_is_supported
+    )
+  )
+    return std::nullopt;
+
+  auto const post = [&](Constr const& c) { return this->post(c, false); };
+  if (policy == NonConvexPolicy::Auto and quadratic_is_supported)
+  {
+    if (is_convex(e))
+      return std::nullopt;
+
+    // the auxiliary variables are created only if linearizing makes e
+    // convex, the linear terms they give not affecting convexity.
+    if (is_convex(detail::nonlinearizable_products(e)))
+      return detail::linearize_products(e, p_impl->m_linearized_products, post);
+
+    spdlog::warn("{} is nonconvex, enabling nonconvex branching.", describe());
+    p_impl->set_non_convex_policy(NonConvexPolicy::Branch);
+    return std::nullopt;
+  }
+
+  // products linearized before reuse their auxiliary variables.
+  auto const linearized = detail::linearize_products(e, p_impl->m_linearized_products, post);
+
+  if (linearized.is_quadratic() and policy == NonConvexPolicy::McCormick)
+    return detail::relax_bilinear_terms(linearized, p_impl->m_bilinear_terms, post);
+
+  if (linearized.quad_coeffs().size() == e.quad_coeffs().size())
+    return std::nullopt;
+  return linearized;
+}
+
 void Solver::set_objective(Sense const& sense, Expr const& e)
 {
-  p_impl->set_objective(sense, e);
+  auto const is_convex = [&](Expr const& o) {
+    return sense == Sense::Minimize ? o.is_convex() : (-o).is_convex();
+  };
+  auto const prepared = prepare_quadratic(
+    e,
+    p_impl->supports_quadratic_objective(),
+    is_convex,
+    [&]() { return fmt::format("Objective {}", e); }
+  );
+  auto objective = prepared.value_or(e);
+
+  // the tangents of a previous objective are no longer refined, but are
+  // reused if its squares come back.
+  for (auto& term: p_impl->m_square_terms)
+    term.is_active = false;
+  if (
+    objective.is_quadratic() and
+    !p_impl->supports_quadratic_objective() and
+    p_impl->m_nr_objective_tangents > 0 and
+    is_convex(objective)
+  )
+  {
+    objective = detail::approximate_squares(
+      objective,
+      p_impl->m_nr_objective_tangents,
+      p_impl->m_square_terms,
+      [&](Constr const& c) { return post(c, false); }
+    );
+  }
+
+  p_impl->set_objective(sense, objective);
+  p_impl->m_objective = {sense, e};
+  if (!p_impl->m_checkpoints.empty())
+    p_impl->m_checkpoints.back().objective_is_changed = true;
 }
 
 double Solver::get_objective_value() const
@@ -98,35 +195,250 @@ void Solver::add(Constr const& constr, bool scale)
   if (constr.must_be_violated())
     throw std::logic_error("Attempt to create a constraint that is trivially unsat.");
 
-  if (scale or m_constraint_autoscale)
-    p_impl->add(constr.scale());
-  else
-    p_impl->add(constr);
+  auto const prepared = prepare_quadratic(
+    constr.expr(),
+    p_impl->supports_quadratic_constraints(),
+    [&](Expr const& e) {
+      return e.is_linear() or (constr.type() == Constr::LessEqual and e.is_convex());
+    },
+    [&]() { return fmt::format("Constraint {}", constr); }
+  );
+  if (prepared.has_value())
+  {
+    if (constr.type() == Constr::Range)
+      add(Constr(*this, prepared.value(), constr.width(), constr.name()), scale);
+    else
+      add(Constr(*this, constr.type(), prepared.value(), constr.name()), scale);
+    return;
+  }
+
+  post(constr, scale);
+}
+
+Constr Solver::post(Constr const& constr, bool scale)
+{
+  auto const posted = (scale or m_constraint_autoscale) ? constr.scale() : constr;
+  p_impl->add(posted);
+  if (!scale and !m_constraint_autoscale)
+    p_impl->register_constr(constr.p_impl);
+  if (!p_impl->m_checkpoints.empty())
+    p_impl->m_checkpoints.back().constrs.push_back(posted);
+  return posted;
 }
 
 void Solver::add(IndicatorConstr const& constr, bool scale)
 {
-  if (
-    p_impl->m_indicator_constraint_policy == 
-      Solver::IndicatorConstraintPolicy::Reformulate or
-    (
-      !supports_indicator_constraint(constr) and
-      p_impl->m_indicator_constraint_policy == 
-      Solver::IndicatorConstraintPolicy::ReformulateIfUnsupported
-    ) or
-    scale
-  )
+  bool reformulate;
+  switch (p_impl->m_indicator_constraint_policy)
+  {
+    case Solver::IndicatorConstraintPolicy::PassThrough:
+      reformulate = false;
+      break;
+    case Solver::IndicatorConstraintPolicy::Reformulate:
+      reformulate = true;
+      break;
+    case Solver::IndicatorConstraintPolicy::ReformulateIfUnsupported:
+      reformulate = !supports_indicator_constraint(constr);
+      break;
+    case Solver::IndicatorConstraintPolicy::Adaptive:
+      if (!supports_indicator_constraint(constr))
+        reformulate = true;
+      else
+      if (!constr.implicant().is_reifiable())
+        reformulate = false;
+      else
+      {
+        // small big-Ms give tight and cheap reformulations, large ones
+        // are numerically dangerous and are better handled natively.
+        double big_m = constr.big_m();
+        reformulate = big_m <= p_impl->m_indicator_big_m_threshold;
+        spdlog::debug(
+          "Indicator constraint {} has big-M {}: {}.",
+          constr, big_m, reformulate ? "reformulating" : "posting natively"
+        );
+      }
+      break;
+    default:
+      assert(false);
+      reformulate = false;
+  }
+
+  if (reformulate or scale)
   {
     for (auto const& c: constr.reformulation())
       add(c, scale);
+    ++p_impl->m_indicator_constraint_stats.nr_reformulated;
+  }
+  else
+  {
+    p_impl->add(constr);
+    ++p_impl->m_indicator_constraint_stats.nr_native;
+  }
+}
+
+void Solver::add(SOSConstr const& constr)
+{
+  if (supports_sos_constraint(constr))
+    p_impl->add(constr);
+  else
+    for (auto const& c: constr.reformulation())
+      add(c);
+}
+
+void Solver::add(GenConstr const& constr)
+{
+  bool reformulate;
+  switch (p_impl->m_general_constraint_policy)
+  {
+    case Solver::GeneralConstraintPolicy::PassThrough:
+      reformulate = false;
+      break;
+    case Solver::GeneralConstraintPolicy::Reformulate:
+      reformulate = true;
+      break;
+    case Solver::GeneralConstraintPolicy::ReformulateIfUnsupported:
+      reformulate = !supports_gen_constraint(constr);
+      break;
+    case Solver::GeneralConstraintPolicy::Adaptive:
+      if (!supports_gen_constraint(constr))
+        reformulate = true;
+      else
+      {
+        double big_m = constr.big_m();
+        reformulate = big_m <= p_impl->m_indicator_big_m_threshold;
+        spdlog::debug(
+          "General constraint {} has big-M {}: {}.",
+          constr, big_m, reformulate ? "reformulating" : "posting natively"
+        );
+      }
+      break;
+    default:
+      assert(false);
+      reformulate = false;
   }
+
+  if (reformulate)
+    for (auto const& c: constr.reformulation())
+      add(c);
   else
     p_impl->add(constr);
 }
 
+void Solver::add(PwlConstr const& constr)
+{
+  if (supports_pwl_constraint(constr))
+    p_impl->add(constr);
+  else
+  if (p_impl->m_pwl_constraint_encoding == PwlConstr::Encoding::SOS2)
+  {
+    auto const [constrs, sos] = constr.sos2_reformulation();
+    for (auto const& c: constrs)
+      add(c);
+    add(sos);
+  }
+  else
+  {
+    for (auto const& c: constr.log_reformulation())
+      add(c);
+  }
+}
+
 void Solver::remove(Constr const& constr)
 {
-  p_impl->remove(constr);
+  remove_constrs({constr});
+}
+
+// Removes posted constraints at once, dropping them from those to clone
+// and from the checkpoints.
+void Solver::remove_constrs(std::vector<Constr> const& constrs)
+{
+  p_impl->remove_constrs(constrs);
+
+  std::set<detail::IConstr const*> removed;
+  for (auto const& constr: constrs)
+  {
+    p_impl->m_constrs.erase(constr.p_impl);
+    removed.insert(constr.p_impl.get());
+  }
+  for (auto& checkpoint: p_impl->m_checkpoints)
+  {
+    auto& posted = checkpoint.constrs;
+    posted.erase(
+      std::remove_if(posted.begin(), posted.end(), [&](auto const& c) {
+        return removed.count(c.p_impl.get()) > 0;
+      }),
+      posted.end()
+    );
+  }
+}
+
+Var Solver::add_column(
+  Var::Type const& type,
+  std::optional<double> const& lb,
+  std::optional<double> const& ub,
+  double obj,
+  std::vector<Constr> const& constrs,
+  std::vector<double> const& coeffs,
+  std::optional<std::string> const& name
+)
+{
+  if (constrs.size() != coeffs.size())
+    throw std::logic_error("Column constraints and coefficients differ in size.");
+  for (auto const& constr: constrs)
+    if (!constr.expr().is_linear())
+      throw std::logic_error("Columns can only be added to linear constraints.");
+
+  Var v(p_impl->create_column(*this, type, lb, ub, obj, constrs, coeffs, name));
+  p_impl->register_var(v.p_impl);
+
+  // keep the expressions of the constraints and the objective in sync
+  // with the backend.
+  for (std::size_t i = 0; i < constrs.size(); ++i)
+    constrs[i].p_impl->m_expr = constrs[i].expr() + coeffs[i] * v;
+  if (obj != 0 and p_impl->m_objective.has_value())
+    p_impl->m_objective->second = p_impl->m_objective->second + obj * v;
+  return v;
+}
+
+void Solver::set_coeff(Constr const& constr, Var const& var, double coeff)
+{
+  p_impl->set_coeff(constr, var, coeff);
+
+  // keep the expression of the constraint in sync with the backend.
+  auto const e = constr.expr();
+  Expr r = e.constant();
+  auto const linear_vars = e.linear_vars();
+  auto const linear_coeffs = e.linear_coeffs();
+  for (std::size_t i = 0; i < linear_vars.size(); ++i)
+    if (!linear_vars[i].is_same(var))
+      r += linear_coeffs[i] * linear_vars[i];
+  if (coeff != 0)
+    r += coeff * var;
+  auto const quad_vars_1 = e.quad_vars_1();
+  auto const quad_vars_2 = e.quad_vars_2();
+  auto const quad_coeffs = e.quad_coeffs();
+  for (std::size_t i = 0; i < quad_coeffs.size(); ++i)
+    r += quad_coeffs[i] * quad_vars_1[i] * quad_vars_2[i];
+  constr.p_impl->m_expr = r;
+}
+
+void Solver::set_rhs(Constr const& constr, double rhs)
+{
+  p_impl->set_rhs(constr, rhs);
+
+  // keep the expression of the constraint in sync with the backend.
+  auto const e = constr.expr();
+  constr.p_impl->m_expr = e - (e.constant() + rhs);
+}
+
+std::vector<double> Solver::duals(std::vector<Constr> const& constrs) const
+{
+  return p_impl->get_duals(constrs);
+}
+
+std::vector<double> Solver::reduced_costs(std::vector<Var> const& vars) const
+{
+  return p_impl->get_reduced_costs(vars);
 }
 
 void Solver::add_lazy_constr_handler(LazyConstrHandler const& constr_handler, bool at_integral_only)
@@ -136,9 +448,658 @@ void Solver::add_lazy_constr_handler(LazyConstrHandler const& constr_handler, bo
 
 std::pair<Solver::Result, bool> Solver::solve()
 {
+  p_impl->restore_integrality();
+  p_impl->m_is_relaxed = false;
+  update_approximations();
+  if (p_impl->m_auto_warm_start and !p_impl->m_incumbent.empty() and p_impl->supports_warm_start())
+    p_impl->set_warm_start(repaired_incumbent());
+  for (std::size_t i = 1; ; ++i)
+  {
+    // a refinement may have discarded the solution of the last solve.
+    if (p_impl->m_is_cancelled)
+      return {Result::Interrupted, false};
+    if (p_impl->m_basis_carry_forward and p_impl->m_carried_basis.has_value())
+      p_impl->set_basis(p_impl->m_carried_basis.value());
+    auto const r = p_impl->solve();
+    if (p_impl->m_auto_warm_start and r.second)
+      capture_incumbent();
+    if (p_impl->m_basis_carry_forward)
+      p_impl->m_carried_basis = p_impl->get_basis();
+    if (
+      !r.second or
+      r.first == Result::Interrupted or
+      i >= p_impl->m_refinement_max_iterations
+    )
+      return r;
+    if (p_impl->m_is_cancelled)
+      return {Result::Interrupted, true};
+    if (!refine_approximations())
+      return r;
+  }
+}
+
+struct Solver::CancellationToken::State
+{
+  std::mutex mutex;
+  bool is_cancelled = false;
+  // the solver solving with the token, if any.
+  detail::ISolver* p_solver = nullptr;
+};
+
+Solver::CancellationToken::CancellationToken(): p_state(std::make_shared<State>())
+{}
+
+void Solver::CancellationToken::cancel() const
+{
+  std::lock_guard<std::mutex> lock(p_state->mutex);
+  p_state->is_cancelled = true;
+  if (p_state->p_solver != nullptr)
+  {
+    p_state->p_solver->m_is_cancelled = true;
+    p_state->p_solver->interrupt();
+  }
+}
+
+bool Solver::CancellationToken::is_cancelled() const
+{
+  std::lock_guard<std::mutex> lock(p_state->mutex);
+  return p_state->is_cancelled;
+}
+
+std::pair<Solver::Result, bool> Solver::solve(CancellationToken const& token)
+{
+  auto& state = *token.p_state;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.is_cancelled)
+      return {Result::Interrupted, false};
+    state.p_solver = p_impl.get();
+  }
+
+  // a cancellation coming after the end of the solve is not to interrupt
+  // the next one.
+  auto const unregister = [&]() {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.p_solver = nullptr;
+    p_impl->m_is_cancelled = false;
+    p_impl->clear_interrupt();
+  };
+  try
+  {
+    auto const r = solve();
+    unregister();
+    return r;
+  }
+  catch (...)
+  {
+    unregister();
+    throw;
+  }
+}
+
+std::future<std::pair<Solver::Result, bool>> Solver::solve_async(
+  CancellationToken const& token
+)
+{
+  // the copy shares the model.
+  return std::async(std::launch::async, [solver = *this, token]() mutable {
+    return solver.solve(token);
+  });
+}
+
+std::pair<Solver::Result, bool> Solver::solve_relaxation(bool fix_integers)
+{
+  update_approximations();
+  p_impl->relax_integrality(fix_integers);
+  p_impl->m_is_relaxed = true;
   return p_impl->solve();
 }
 
+Solver::SweepStep Solver::solve_step(
+  std::function<void(double)> const& set_parameter, std::size_t index, double value
+)
+{
+  set_parameter(value);
+  auto const [result, has_solution] = solve();
+  return {
+    index,
+    value,
+    result,
+    has_solution,
+    has_solution ? get_objective_value() : std::numeric_limits<double>::quiet_NaN()
+  };
+}
+
+void Solver::sweep(
+  std::function<void(double)> const& set_parameter,
+  std::vector<double> const& values,
+  SweepCallback const& callback
+)
+{
+  // the settings are enabled keeping the incumbent and the basis of the
+  // last solve, and what the sweep gathered is dropped if they were off.
+  bool const basis_carry_forward = p_impl->m_basis_carry_forward;
+  bool const auto_warm_start = p_impl->m_auto_warm_start;
+  p_impl->m_basis_carry_forward = true;
+  p_impl->m_auto_warm_start = true;
+
+  auto const restore_settings = [&]() {
+    if (!basis_carry_forward)
+      set_basis_carry_forward(false);
+    if (!auto_warm_start)
+      set_auto_warm_start(false);
+  };
+  try
+  {
+    for (std::size_t i = 0; i < values.size(); ++i)
+      callback(*this, solve_step(set_parameter, i, values[i]));
+  }
+  catch (...)
+  {
+    restore_settings();
+    throw;
+  }
+  restore_settings();
+}
+
+void Solver::sweep(
+  Backend backend,
+  std::function<std::function<void(double)>(Solver&)> const& build,
+  std::vector<double> const& values,
+  SweepCallback const& callback,
+  std::size_t nr_instances
+)
+{
+  if (nr_instances == 0)
+    throw std::logic_error("Attempt to sweep with no solver instance.");
+
+  // chunks are small enough to balance the load, and consecutive values
+  // keep the warm starts relevant.
+  std::size_t const chunk_size = std::max<std::size_t>(1, values.size() / (4 * nr_instances));
+  std::atomic<std::size_t> next_chunk{0};
+  std::mutex callback_mutex;
+
+  auto const run_instance = [&]() {
+    Solver solver(backend, false);
+    auto const set_parameter = build(solver);
+    solver.set_basis_carry_forward(true);
+    solver.set_auto_warm_start(true);
+    for (;;)
+    {
+      std::size_t const begin = chunk_size * next_chunk++;
+      if (begin >= values.size())
+        return;
+      for (std::size_t i = begin; i < std::min(begin + chunk_size, values.size()); ++i)
+      {
+        auto const step = solver.solve_step(set_parameter, i, values[i]);
+        std::lock_guard<std::mutex> lock(callback_mutex);
+        callback(solver, step);
+      }
+    }
+  };
+
+  std::vector<std::future<void>> instances;
+  for (std::size_t i = 0; i < std::min(nr_instances, values.size()); ++i)
+    instances.push_back(std::async(std::launch::async, run_instance));
+  for (auto& instance: instances)
+    instance.get();
+}
+
+Solver::Solver(Backend backend, std::shared_ptr<detail::ISolver> const& p_impl):
+  p_impl(p_impl), m_backend(backend), m_constraint_autoscale(false)
+{}
+
+std::pair<Solver, Solver::Remapping> Solver::clone() const
+{
+  p_impl->update_if_pending();
+
+  Solver r(m_backend, p_impl->clone());
+  r.m_constraint_autoscale = m_constraint_autoscale;
+  auto& impl = *r.p_impl;
+  // the relaxation of the last solve_relaxation is not part of the model
+  // (the source keeps it, along with its solution).
+  impl.restore_integrality();
+  impl.m_non_convex_policy = p_impl->m_non_convex_policy;
+  impl.m_indicator_constraint_policy = p_impl->m_indicator_constraint_policy;
+  impl.m_general_constraint_policy = p_impl->m_general_constraint_policy;
+  impl.m_pwl_constraint_encoding = p_impl->m_pwl_constraint_encoding;
+  impl.m_indicator_big_m_threshold = p_impl->m_indicator_big_m_threshold;
+  impl.m_indicator_constraint_stats = p_impl->m_indicator_constraint_stats;
+  impl.m_nr_objective_tangents = p_impl->m_nr_objective_tangents;
+  impl.m_refinement_max_iterations = p_impl->m_refinement_max_iterations;
+  impl.m_refinement_tolerance = p_impl->m_refinement_tolerance;
+  impl.m_basis_carry_forward = p_impl->m_basis_carry_forward;
+  impl.m_auto_warm_start = p_impl->m_auto_warm_start;
+
+  Remapping remapping;
+  for (auto const& p_var: p_impl->m_vars)
+  {
+    if (p_var.expired())
+      continue;
+    auto p_copy = impl.clone_var(r, *p_var.lock());
+    if (p_copy == nullptr)
+      continue;
+    remapping.m_vars[p_var] = p_copy;
+    impl.register_var(p_copy);
+  }
+
+  for (auto const& p_constr: p_impl->m_constrs)
+  {
+    if (p_constr.expired())
+      continue;
+    Constr constr(p_constr.lock());
+    auto const e = remapping.remapped(constr.expr());
+    if (!e.has_value())
+      continue;
+    Constr copy = constr.type() == Constr::Range
+      ? Constr(r, e.value(), constr.width(), constr.name())
+      : Constr(r, constr.type(), e.value(), constr.name());
+    if (!impl.bind_cloned_constr(constr, copy))
+      continue;
+    remapping.m_constrs[p_constr] = copy.p_impl;
+    impl.register_constr(copy.p_impl);
+  }
+
+  // the auxiliary variables of linearized products keep being reused,
+  // and the approximations refined, in the copy.
+  for (auto const& [key, product]: p_impl->m_linearized_products)
+  {
+    auto v1 = remapping.remapped(key.first);
+    auto v2 = remapping.remapped(key.second);
+    auto w = remapping.remapped(product.w);
+    if (!v1.has_value() or !v2.has_value() or !w.has_value())
+      continue;
+    detail::LinearizedProduct copy{w.value(), {}, product.lb, product.ub};
+    for (auto const& def: product.defs)
+    {
+      auto it = remapping.m_constrs.find(def.p_impl);
+      if (it == remapping.m_constrs.end())
+        break;
+      copy.defs.push_back(Constr(it->second));
+    }
+    if (copy.defs.size() != product.defs.size())
+      continue;
+    auto key_copy = std::less<Var>()(v1.value(), v2.value())
+      ? std::make_pair(v1.value(), v2.value())
+      : std::make_pair(v2.value(), v1.value());
+    impl.m_linearized_products.emplace(key_copy, copy);
+  }
+  for (auto const& term: p_impl->m_bilinear_terms)
+  {
+    auto x = remapping.remapped(term.x);
+    auto y = remapping.remapped(term.y);
+    auto w = remapping.remapped(term.w);
+    if (!x.has_value() or !y.has_value() or !w.has_value())
+      continue;
+    impl.m_bilinear_terms.push_back(
+      {x.value(), y.value(), w.value(), term.breakpoints, {}, {}, term.y_lb, term.y_ub}
+    );
+
+    // without the counterpart of its whole envelope (e.g. scaled), the
+    // envelope of the copy is left in place when refined.
+    auto& copy = impl.m_bilinear_terms.back();
+    for (auto const& c: term.envelope)
+    {
+      auto it = remapping.m_constrs.find(c.p_impl);
+      if (it != remapping.m_constrs.end())
+        copy.envelope.push_back(Constr(it->second));
+    }
+    for (auto const& [l, l_y]: term.selectors)
+    {
+      auto l_copy = remapping.remapped(l);
+      auto l_y_copy = remapping.remapped(l_y);
+      if (l_copy.has_value() and l_y_copy.has_value())
+        copy.selectors.emplace_back(l_copy.value(), l_y_copy.value());
+    }
+    if (
+      copy.envelope.size() != term.envelope.size() or
+      copy.selectors.size() != term.selectors.size()
+    )
+    {
+      copy.envelope.clear();
+      copy.selectors.clear();
+    }
+  }
+  for (auto const& term: p_impl->m_square_terms)
+  {
+    auto x = remapping.remapped(term.x);
+    auto t = remapping.remapped(term.t);
+    if (x.has_value() and t.has_value())
+      impl.m_square_terms.push_back({x.value(), t.value(), term.points, term.is_active});
+  }
+
+  if (p_impl->m_objective.has_value())
+  {
+    auto const objective = remapping.remapped(p_impl->m_objective->second);
+    if (objective.has_value())
+      impl.m_objective = {p_impl->m_objective->first, objective.value()};
+  }
+
+  impl.finish_clone(remapping);
+  return {r, remapping};
+}
+
+void Solver::push()
+{
+  p_impl->m_checkpoints.emplace_back();
+  auto& checkpoint = p_impl->m_checkpoints.back();
+  checkpoint.objective = p_impl->m_objective;
+  checkpoint.products = p_impl->m_linearized_products;
+  checkpoint.nr_bilinear_terms = p_impl->m_bilinear_terms.size();
+  for (auto const& term: p_impl->m_square_terms)
+    checkpoint.nr_square_points.push_back(term.points.size());
+}
+
+void Solver::pop()
+{
+  if (p_impl->m_checkpoints.empty())
+    throw std::logic_error("Attempt to pop a checkpoint without a matching push.");
+  auto checkpoint = std::move(p_impl->m_checkpoints.back());
+  p_impl->m_checkpoints.pop_back();
+
+  std::set<detail::IConstr const*> removed;
+  if (!checkpoint.constrs.empty())
+    remove_constrs(checkpoint.constrs);
+  for (auto const& constr: checkpoint.constrs)
+    removed.insert(constr.p_impl.get());
+  auto const is_removed = [&](Constr const& c) { return removed.count(c.p_impl.get()) > 0; };
+
+  // the products linearized since are linearized anew if posted again,
+  // those redefined since get their definitions back at the next solve
+  // (over the restored bounds).
+  auto& products = p_impl->m_linearized_products;
+  for (auto& [key, product]: checkpoint.products)
+  {
+    auto const it = products.find(key);
+    bool const is_redefined = it != products.end() and !std::equal(
+      product.defs.begin(), product.defs.end(),
+      it->second.defs.begin(), it->second.defs.end(),
+      [](auto const& c1, auto const& c2) { return c1.p_impl == c2.p_impl; }
+    );
+    if (is_redefined)
+      product.defs.clear();
+  }
+  products = std::move(checkpoint.products);
+
+  // the relaxation of the last solve_relaxation ends first, its bounds
+  // being restored over the popped ones otherwise.
+  if (p_impl->m_is_relaxed)
+  {
+    p_impl->restore_integrality();
+    p_impl->m_is_relaxed = false;
+  }
+  for (auto const& [p_var, bounds]: checkpoint.bounds)
+  {
+    // the bounds are restored in an order keeping them consistent.
+    auto const [lb, ub] = bounds;
+    if (lb > p_var->ub())
+    {
+      p_var->set_ub(ub);
+      p_var->set_lb(lb);
+    }
+    else
+    {
+      p_var->set_lb(lb);
+      p_var->set_ub(ub);
+    }
+  }
+
+  // the bilinear terms created since relaxed what was rolled back, those
+  // refined since get the envelope of their current partition back (over
+  // the restored bounds).
+  auto& bilinear_terms = p_impl->m_bilinear_terms;
+  bilinear_terms.erase(
+    bilinear_terms.begin() + std::min(checkpoint.nr_bilinear_terms, bilinear_terms.size()),
+    bilinear_terms.end()
+  );
+  for (auto& term: bilinear_terms)
+  {
+    auto& envelope = term.envelope;
+    if (std::none_of(envelope.begin(), envelope.end(), is_removed))
+      continue;
+    envelope.erase(std::remove_if(envelope.begin(), envelope.end(), is_removed), envelope.end());
+    if (!envelope.empty())
+      remove_constrs(envelope);
+    envelope.clear();
+    for (auto const& c: detail::mccormick_envelope(term))
+      envelope.push_back(post(c, false));
+  }
+
+  // so do the squares, the tangents added since being removed.
+  auto& square_terms = p_impl->m_square_terms;
+  auto const& nr_square_points = checkpoint.nr_square_points;
+  square_terms.erase(
+    square_terms.begin() + std::min(nr_square_points.size(), square_terms.size()),
+    square_terms.end()
+  );
+  for (std::size_t j = 0; j < square_terms.size(); ++j)
+    square_terms[j].points.resize(std::min(nr_square_points[j], square_terms[j].points.size()));
+
+  if (checkpoint.objective_is_changed)
+  {
+    if (checkpoint.objective.has_value())
+      set_objective(checkpoint.objective->first, checkpoint.objective->second);
+    else
+      set_objective(p_impl->m_objective->first, Expr());
+  }
+}
+
+// Records the bounds of v before they change in the current checkpoint.
+void Solver::journal_bounds(Var const& v) const
+{
+  if (p_impl->m_checkpoints.empty())
+    return;
+  auto& bounds = p_impl->m_checkpoints.back().bounds;
+  if (bounds.find(v.p_impl) == bounds.end())
+    bounds[v.p_impl] = {v.p_impl->lb(), v.p_impl->ub()};
+}
+
+Var Solver::Remapping::var(Var const& v) const
+{
+  auto r = remapped(v);
+  if (!r.has_value())
+    throw std::logic_error("Variable has no counterpart in the clone.");
+  return r.value();
+}
+
+Constr Solver::Remapping::constr(Constr const& c) const
+{
+  auto it = m_constrs.find(c.p_impl);
+  if (it == m_constrs.end())
+    throw std::logic_error("Constraint has no counterpart in the clone.");
+  return Constr(it->second);
+}
+
+Expr Solver::Remapping::expr(Expr const& e) const
+{
+  auto r = remapped(e);
+  if (!r.has_value())
+    throw std::logic_error("Expression has variables without counterpart in the clone.");
+  return r.value();
+}
+
+std::optional<Var> Solver::Remapping::remapped(Var const& v) const
+{
+  auto it = m_vars.find(v.p_impl);
+  if (it == m_vars.end())
+    return std::nullopt;
+  return Var(it->second);
+}
+
+std::optional<Expr> Solver::Remapping::remapped(Expr const& e) const
+{
+  Expr r = e.constant();
+
+  auto linear_vars = e.linear_vars();
+  auto linear_coeffs = e.linear_coeffs();
+  for (std::size_t i = 0; i < linear_vars.size(); ++i)
+  {
+    auto v = remapped(linear_vars[i]);
+    if (!v.has_value())
+      return std::nullopt;
+    r += linear_coeffs[i] * v.value();
+  }
+
+  auto quad_vars_1 = e.quad_vars_1();
+  auto quad_vars_2 = e.quad_vars_2();
+  auto quad_coeffs = e.quad_coeffs();
+  for (std::size_t i = 0; i < quad_coeffs.size(); ++i)
+  {
+    auto v1 = remapped(quad_vars_1[i]);
+    auto v2 = remapped(quad_vars_2[i]);
+    if (!v1.has_value() or !v2.has_value())
+      return std::nullopt;
+    r += quad_coeffs[i] * v1.value() * v2.value();
+  }
+
+  return r;
+}
+
+void Solver::capture_incumbent()
+{
+  auto& vars = p_impl->m_vars;
+  vars.erase(
+    std::remove_if(vars.begin(), vars.end(), [](auto const& p) { return p.expired(); }),
+    vars.end()
+  );
+  p_impl->m_incumbent.clear();
+  for (auto const& p_var: vars)
+    p_impl->m_incumbent[p_var] = Var(p_var.lock()).value();
+}
+
+// The incumbent completed with the values of the variables created since,
+// set to the value of their domain closest to zero.
+PartialSolution Solver::repaired_incumbent() const
+{
+  PartialSolution r;
+  for (auto const& p_var: p_impl->m_vars)
+  {
+    if (p_var.expired())
+      continue;
+    Var v(p_var.lock());
+    auto it = p_impl->m_incumbent.find(p_var);
+    if (it != p_impl->m_incumbent.end())
+    {
+      r[v] = it->second;
+      continue;
+    }
+    double lb = v.domain_lb(), ub = v.domain_ub();
+    if (v.type() != Var::Type::Continuous and v.type() != Var::Type::SemiContinuous)
+    {
+      lb = std::ceil(lb);
+      ub = std::floor(ub);
+    }
+    // no integer value lies within fractional bounds less than one apart.
+    if (lb > ub)
+      continue;
+    r[v] = std::clamp(0.0, lb, ub);
+  }
+  return r;
+}
+
+// Posts anew the definitions of the linearized products and the
+// envelopes of the bilinear terms built on other domains than the current
+// ones, the partitions of the latter starting over.
+void Solver::update_approximations()
+{
+  auto& products = p_impl->m_linearized_products;
+  auto& bilinear_terms = p_impl->m_bilinear_terms;
+  std::vector<detail::LinearizedProducts::iterator> outdated_products;
+  std::vector<std::size_t> outdated_bilinear;
+  std::vector<Constr> superseded;
+  for (auto it = products.begin(); it != products.end(); ++it)
+  {
+    if (!detail::is_outdated(it->first, it->second))
+      continue;
+    outdated_products.push_back(it);
+    auto const& defs = it->second.defs;
+    superseded.insert(superseded.end(), defs.begin(), defs.end());
+  }
+  for (std::size_t j = 0; j < bilinear_terms.size(); ++j)
+  {
+    if (!detail::is_outdated(bilinear_terms[j]))
+      continue;
+    outdated_bilinear.push_back(j);
+    auto& envelope = bilinear_terms[j].envelope;
+    superseded.insert(superseded.end(), envelope.begin(), envelope.end());
+    envelope.clear();
+  }
+  if (!superseded.empty())
+    remove_constrs(superseded);
+
+  auto const post = [&](Constr const& c) { return this->post(c, false); };
+  for (auto it: outdated_products)
+    detail::redefine(it->first, it->second, post);
+  for (auto j: outdated_bilinear)
+  {
+    auto& term = bilinear_terms[j];
+    detail::reset(term);
+    for (auto const& c: detail::mccormick_envelope(term))
+      term.envelope.push_back(post(c));
+  }
+}
+
+// Refines the McCormick relaxations and the tangent approximations that
+// are not tight enough at the solution found, warm-starting the next
+// solve from it. Returns if anything was refined.
+bool Solver::refine_approximations()
+{
+  auto& bilinear_terms = p_impl->m_bilinear_terms;
+  auto& square_terms = p_impl->m_square_terms;
+  if (bilinear_terms.empty() and square_terms.empty())
+    return false;
+
+  // all values are read before the model is modified since some
+  // backends discard the solution then.
+  double const tolerance = p_impl->m_refinement_tolerance;
+  PartialSolution warm_start;
+  std::vector<std::size_t> refined_bilinear, refined_squares;
+  for (std::size_t j = 0; j < bilinear_terms.size(); ++j)
+  {
+    auto& term = bilinear_terms[j];
+    warm_start[term.x] = term.x.value();
+    warm_start[term.y] = term.y.value();
+    if (detail::refine(term, tolerance))
+      refined_bilinear.push_back(j);
+  }
+  for (std::size_t j = 0; j < square_terms.size(); ++j)
+  {
+    auto& term = square_terms[j];
+    if (!term.is_active)
+      continue;
+    warm_start[term.x] = term.x.value();
+    if (detail::refine(term, tolerance))
+      refined_squares.push_back(j);
+  }
+  if (refined_bilinear.empty() and refined_squares.empty())
+    return false;
+
+  spdlog::debug(
+    "Refining {} of {} bilinear terms and {} of {} squares.",
+    refined_bilinear.size(), bilinear_terms.size(),
+    refined_squares.size(), square_terms.size()
+  );
+  // the refined envelopes replace the previous ones, removed at once.
+  std::vector<Constr> superseded;
+  for (auto j: refined_bilinear)
+  {
+    auto& envelope = bilinear_terms[j].envelope;
+    superseded.insert(superseded.end(), envelope.begin(), envelope.end());
+    envelope.clear();
+  }
+  if (!superseded.empty())
+    remove_constrs(superseded);
+  for (auto j: refined_bilinear)
+    for (auto const& c: detail::mccormick_envelope(bilinear_terms[j]))
+      bilinear_terms[j].envelope.push_back(post(c, false));
+  for (auto j: refined_squares)
+    post(detail::tangent(square_terms[j], square_terms[j].points.back()), false);
+
+  if (p_impl->supports_warm_start())
+    p_impl->set_warm_start(warm_start);
+  return true;
+}
+
 std::pair<Solver::Result, bool> Solver::maximize(Expr const& e)
 {
   set_objective(Sense::Maximize, e);
@@ -153,6 +1114,7 @@ std::pair<Solver::Result, bool> Solver::minimize(Expr const& e)
 
 void Solver::set_non_convex_policy(NonConvexPolicy policy)
 {
+  p_impl->m_non_convex_policy = policy;
   p_impl->set_non_convex_policy(policy);
 }
 
@@ -161,11 +1123,51 @@ void Solver::set_indicator_constraint_policy(IndicatorConstraintPolicy policy)
   p_impl->set_indicator_constraint_policy(policy);
 }
 
+void Solver::set_general_constraint_policy(GeneralConstraintPolicy policy)
+{
+  p_impl->m_general_constraint_policy = policy;
+}
+
+void Solver::set_pwl_constraint_encoding(PwlConstr::Encoding encoding)
+{
+  p_impl->m_pwl_constraint_encoding = encoding;
+}
+
+void Solver::set_indicator_big_m_threshold(double value)
+{
+  p_impl->m_indicator_big_m_threshold = value;
+}
+
+double Solver::get_indicator_big_m_threshold() const
+{
+  return p_impl->m_indicator_big_m_threshold;
+}
+
+Solver::IndicatorConstraintStats const& Solver::indicator_constraint_stats() const
+{
+  return p_impl->m_indicator_constraint_stats;
+}
+
 void Solver::set_constraint_autoscale(bool autoscale)
 {
   m_constraint_autoscale = autoscale;
 }
 
+void Solver::set_quadratic_objective_tangents(std::size_t nr_tangents)
+{
+  p_impl->m_nr_objective_tangents = nr_tangents;
+}
+
+void Solver::set_refinement_max_iterations(std::size_t max_iterations)
+{
+  p_impl->m_refinement_max_iterations = max_iterations;
+}
+
+void Solver::set_refinement_tolerance(double tolerance)
+{
+  p_impl->m_refinement_tolerance = tolerance;
+}
+
 void Solver::set_feasibility_tolerance(double value)
 {
   p_impl->set_feasibility_tolerance(value);
@@ -206,6 +1208,21 @@ bool Solver::supports_indicator_constraint(IndicatorConstr const& constr) const
   return p_impl->supports_indicator_constraint(constr); 
 }
 
+bool Solver::supports_sos_constraint(SOSConstr const& constr) const
+{
+  return p_impl->supports_sos_constraint(constr);
+}
+
+bool Solver::supports_gen_constraint(GenConstr const& constr) const
+{
+  return p_impl->supports_gen_constraint(constr);
+}
+
+bool Solver::supports_pwl_constraint(PwlConstr const& constr) const
+{
+  return p_impl->supports_pwl_constraint(constr);
+}
+
 bool Solver::supports_quadratic_constraints() const
 {
   return p_impl->supports_quadratic_constraints();
@@ -292,6 +1309,34 @@ void Solver::set_warm_start(PartialSolution const& partial_solution)
   p_impl->set_warm_start(partial_solution);
 }
 
+Solver::Basis Solver::get_basis() const
+{
+  auto basis = p_impl->get_basis();
+  if (!basis.has_value())
+    throw std::logic_error("No LP basis is available.");
+  return basis.value();
+}
+
+void Solver::set_basis(Basis const& basis)
+{
+  if (!p_impl->set_basis(basis))
+    throw std::logic_error("Basis does not match the dimensions of the model.");
+  // the next solve starts from this basis, not from the carried one
+  p_impl->m_carried_basis.reset();
+}
+
+void Solver::set_auto_warm_start(bool auto_warm_start)
+{
+  p_impl->m_auto_warm_start = auto_warm_start;
+  p_impl->m_incumbent.clear();
+}
+
+void Solver::set_basis_carry_forward(bool carry_forward)
+{
+  p_impl->m_basis_carry_forward = carry_forward;
+  p_impl->m_carried_basis.reset();
+}
+
 void Solver::set_reoptimizing(bool value)
 {
   p_impl->set_reoptimizing(value);
@@ -326,6 +1371,63 @@ void ISolver::set_indicator_constraint_policy(Solver::IndicatorConstraintPolicy
   m_indicator_constraint_policy = policy;
 }
 
+void ISolver::remove_constrs(std::vector<Constr> const& constrs)
+{
+  for (auto const& constr: constrs)
+    remove(constr);
+}
+
+void ISolver::register_var(std::shared_ptr<IVar> const& p_var)
+{
+  if (m_vars.size() > 2 * m_nr_vars_at_pruning)
+  {
+    m_vars.erase(
+      std::remove_if(m_vars.begin(), m_vars.end(), [](auto const& p) { return p.expired(); }),
+      m_vars.end()
+    );
+    m_nr_vars_at_pruning = m_vars.size();
+  }
+  m_vars.push_back(p_var);
+}
+
+void ISolver::register_constr(std::shared_ptr<IConstr> const& p_constr)
+{
+  if (m_constrs.size() > 2 * m_nr_constrs_at_pruning)
+  {
+    for (auto it = m_constrs.begin(); it != m_constrs.end();)
+      it = it->expired() ? m_constrs.erase(it) : std::next(it);
+    m_nr_constrs_at_pruning = m_constrs.size();
+  }
+  m_constrs.insert(p_constr);
+}
+
+bool ISolver::set_basis(Solver::Basis const&)
+{
+  throw std::logic_error("Backend does not support setting the LP basis.");
+}
+
+std::pair<double, double> relaxed_bounds(
+  bool is_integer,
+  bool is_semi,
+  double lb,
+  double ub,
+  std::optional<double> const& value,
+  double tolerance
+)
+{
+  if (!value.has_value())
+  {
+    if (is_semi)
+      return {std::min(lb, 0.0), std::max(ub, 0.0)};
+    return {lb, ub};
+  }
+  if (is_integer)
+    return {std::round(value.value()), std::round(value.value())};
+  if (std::abs(value.value()) <= tolerance)
+    return {0, 0};
+  return {lb, ub};
+}
+
 }
 
 std::ostream& operator<<(std::ostream& os, Solver::Backend const& solver_backend)
@@ -1,14 +1,31 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <map>
+#include <set>
+#include <functional>
+#include <future>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#  include <coroutine>
+#  include <thread>
+#  define MIPLIB_WITH_COROUTINES
+#endif
 
 #include "var.hpp"
 #include "constr.hpp"
 #include "lazy.hpp"
+#include "util/linearize.hpp"
+#include "util/mccormick.hpp"
+#include "util/tangents.hpp"
 
 namespace miplib {
 
+static double constexpr DEFAULT_INDICATOR_BIG_M_THRESHOLD = 1e4;
+static std::size_t constexpr DEFAULT_REFINEMENT_MAX_ITERATIONS = 10;
+static double constexpr DEFAULT_REFINEMENT_TOLERANCE = 1e-4;
+
 struct Solver;
 
 namespace detail {
@@ -18,8 +35,23 @@ struct ISolver;
 struct Solver
 {
   enum class Backend { Gurobi, Scip, Lpsolve, BestAtCompileTime, BestAtRunTime };
-  enum class NonConvexPolicy { Error, Linearize, Branch };
-  enum class IndicatorConstraintPolicy { PassThrough, Reformulate, ReformulateIfUnsupported };
+  // Linearize also replaces products involving binary variables
+  // by auxiliary variables and linear constraints.
+  // McCormick does so too and relaxes the other products of bounded
+  // variables with McCormick envelopes, which solve() refines until
+  // the relaxation is tight at the solution found.
+  // Auto posts convex expressions as is, linearizes products with binaries
+  // when that makes them convex and otherwise falls back to Branch,
+  // logging the nonconvex constraints.
+  enum class NonConvexPolicy { Error, Linearize, Branch, McCormick, Auto };
+  // Adaptive: reformulate if not supported by the backend, or if the
+  // big-M of the reformulation is within the configured threshold.
+  enum class IndicatorConstraintPolicy {
+    PassThrough, Reformulate, ReformulateIfUnsupported, Adaptive
+  };
+  // General constraints are posted under the same policies, Adaptive
+  // sharing the indicator big-M threshold.
+  using GeneralConstraintPolicy = IndicatorConstraintPolicy;
   enum class Sense { Maximize, Minimize };
   enum class Result {
     Optimal,
@@ -31,6 +63,77 @@ struct Solver
     Other
   };
 
+  // Status of the variables (columns) and of the slacks of the linear
+  // constraints (rows) in an LP basis, ordered as the backend stores them,
+  // i.e. as posted.
+  enum class BasisStatus { Basic, AtLower, AtUpper, Superbasic };
+  struct Basis
+  {
+    std::vector<BasisStatus> vars;
+    std::vector<BasisStatus> constrs;
+  };
+
+  // Outcome of a step of a sweep (objective_value is meaningful only if
+  // has_solution).
+  struct SweepStep
+  {
+    std::size_t index;
+    double value;
+    Result result;
+    bool has_solution;
+    double objective_value;
+  };
+  using SweepCallback = std::function<void(Solver const&, SweepStep const&)>;
+
+  // Counterparts in a clone (see clone) of the variables and of the
+  // constraints posted as given, i.e. neither reformulated nor scaled.
+  struct Remapping
+  {
+    Var var(Var const& v) const;
+    Constr constr(Constr const& c) const;
+    // e over the counterparts of its variables.
+    Expr expr(Expr const& e) const;
+
+    private:
+    std::optional<Var> remapped(Var const& v) const;
+    std::optional<Expr> remapped(Expr const& e) const;
+
+    std::map<
+      std::weak_ptr<detail::IVar>,
+      std::shared_ptr<detail::IVar>,
+      std::owner_less<std::weak_ptr<detail::IVar>>
+    > m_vars;
+    std::map<
+      std::weak_ptr<detail::IConstr>,
+      std::shared_ptr<detail::IConstr>,
+      std::owner_less<std::weak_ptr<detail::IConstr>>
+    > m_constrs;
+    friend struct Solver;
+  };
+
+  // Shared by the thread solving and those that may cancel the solve:
+  // cancel() interrupts the ongoing solve (if any) and those started
+  // with the token afterwards.
+  struct CancellationToken
+  {
+    CancellationToken();
+
+    void cancel() const;
+    bool is_cancelled() const;
+
+    private:
+    struct State;
+    std::shared_ptr<State> p_state;
+    friend struct Solver;
+  };
+
+  // How indicator constraints were posted so far.
+  struct IndicatorConstraintStats
+  {
+    std::size_t nr_native = 0;
+    std::size_t nr_reformulated = 0;
+  };
+
   Solver(Backend backend, bool verbose=true);
 
   Backend const& backend() const
@@ -46,14 +149,63 @@ struct Solver
   // note: if scale=true then the constraint will be first
   // reformulated to a linear expression and then scaled.
   void add(IndicatorConstr const& constr, bool scale = false);
+  // posted natively if supported by the backend, reformulated otherwise.
+  void add(SOSConstr const& constr);
+  void add(GenConstr const& constr);
+  // posted natively if supported by the backend, reformulated
+  // with the configured encoding otherwise.
+  void add(PwlConstr const& constr);
 
   void remove(Constr const& constr);
 
+  // Adds a variable along with its objective coefficient and its
+  // coefficients in already posted linear constraints.
+  Var add_column(
+    Var::Type const& type,
+    std::optional<double> const& lb,
+    std::optional<double> const& ub,
+    double obj,
+    std::vector<Constr> const& constrs,
+    std::vector<double> const& coeffs,
+    std::optional<std::string> const& name = std::nullopt
+  );
+
+  // Modify a posted constraint in place: the coefficient of var in its
+  // linear part, and its right-hand side, i.e. minus the constant of its
+  // expression (ranges keep their width).
+  void set_coeff(Constr const& constr, Var const& var, double coeff);
+  void set_rhs(Constr const& constr, double rhs);
+
+  // Dual values of posted constraints, i.e. the rates of change of the
+  // objective with their right-hand sides, and reduced costs of variables,
+  // in the last solution of a continuous problem. Each batch is retrieved
+  // from the backend at once. SCIP reports them for its presolved problem
+  // (reduced costs of the root relaxation), so they are only exact there
+  // with presolving disabled.
+  std::vector<double> duals(std::vector<Constr> const& constrs) const;
+  std::vector<double> reduced_costs(std::vector<Var> const& vars) const;
+
   void add_lazy_constr_handler(LazyConstrHandler const& constr_handler, bool at_integral_only);
 
   void set_non_convex_policy(NonConvexPolicy policy);
   void set_indicator_constraint_policy(IndicatorConstraintPolicy policy);
+  void set_general_constraint_policy(GeneralConstraintPolicy policy);
+  void set_pwl_constraint_encoding(PwlConstr::Encoding encoding);
+  // Big-M threshold used by IndicatorConstraintPolicy::Adaptive.
+  void set_indicator_big_m_threshold(double value);
+  double get_indicator_big_m_threshold() const;
+  IndicatorConstraintStats const& indicator_constraint_stats() const;
   void set_constraint_autoscale(bool autoscale);
+  // Opt-in outer approximation of separable convex quadratic objectives
+  // on backends without quadratic objectives: each c * x * x is replaced
+  // by c * t with t above nr_tangents tangents of x * x (0 disables it),
+  // solve() adding tangents where t underestimates x * x.
+  void set_quadratic_objective_tangents(std::size_t nr_tangents);
+  // Refinement of McCormick relaxations and tangent approximations: at
+  // most max_iterations resolves, stopping once all errors are within the
+  // (relative) tolerance. The result is then that of the last one solved.
+  void set_refinement_max_iterations(std::size_t max_iterations);
+  void set_refinement_tolerance(double tolerance);
 
   void set_int_feasibility_tolerance(double value);
   void set_feasibility_tolerance(double value);
@@ -67,11 +219,71 @@ struct Solver
   // returns Result and if there is a solution.
   std::pair<Result, bool> solve();
 
+  // Solve that can be cancelled from another thread through the token,
+  // its result then being Interrupted (with the best solution found, if
+  // any). The cancellation is checked before each solve of the backend,
+  // and one coming while the backend starts may still be missed by Gurobi
+  // and SCIP, which then solve to the end.
+  std::pair<Result, bool> solve(CancellationToken const& token);
+  // The same in another thread; the model is not to be modified until
+  // the result is available.
+  std::future<std::pair<Result, bool>> solve_async(
+    CancellationToken const& token = CancellationToken()
+  );
+
+  // Solves the continuous relaxation of the model in place, integrality
+  // being dropped until the next solve(). With fix_integers, the integer
+  // variables are first fixed to their values in the current solution
+  // (and semi-continuous ones to zero or their nonzero domain), e.g. to
+  // get the duals of a MIP solution.
+  std::pair<Result, bool> solve_relaxation(bool fix_integers = false);
+
+  // Solves the model for each of the values of a parameter, applied in
+  // place by set_parameter (e.g. through set_rhs), each solve starting
+  // from the basis and solution of the previous one (basis carry forward
+  // and auto warm start are enabled during the sweep, then set back).
+  // callback is called after each solve.
+  void sweep(
+    std::function<void(double)> const& set_parameter,
+    std::vector<double> const& values,
+    SweepCallback const& callback
+  );
+
+  // Splits a sweep over nr_instances solvers of the given backend, each
+  // model being built by build, which returns its parameter setter. Idle
+  // instances take the next chunk of consecutive values, and callback is
+  // called from one instance at a time.
+  static void sweep(
+    Backend backend,
+    std::function<std::function<void(double)>(Solver&)> const& build,
+    std::vector<double> const& values,
+    SweepCallback const& callback,
+    std::size_t nr_instances
+  );
+
+  // Independent copy of the backend model along with its settings, e.g.
+  // to solve variants of a model built once concurrently, one solver per
+  // thread. Lazy constraint handlers, warm starts and solutions are not
+  // copied, nor are the counterparts of indicator, SOS, general and
+  // piecewise linear constraints available.
+  std::pair<Solver, Remapping> clone() const;
+
+  // Checkpoints of the model: pop() rolls back the bound changes, the
+  // (linear and quadratic) constraints posted and the objective set since
+  // the matching push(). Other constraints and variables are kept. Open
+  // checkpoints keep the variables and constraints involved alive and
+  // are not cloned.
+  void push();
+  void pop();
+
   // shortcut for set_objective and solve;
   std::pair<Result, bool> maximize(Expr const& e);
   std::pair<Result, bool> minimize(Expr const& e);
 
   bool supports_indicator_constraint(IndicatorConstr const& constr) const;
+  bool supports_sos_constraint(SOSConstr const& constr) const;
+  bool supports_gen_constraint(GenConstr const& constr) const;
+  bool supports_pwl_constraint(PwlConstr const& constr) const;
 
   bool supports_quadratic_constraints() const;
   bool supports_quadratic_objective() const;
@@ -92,6 +304,18 @@ struct Solver
 
   // Used to build initial feasible solution.
   void set_warm_start(PartialSolution const& partial_solution);
+  // Warm starts each solve from the solution of the previous one, the
+  // variables created since then taking the value of their domain
+  // closest to zero.
+  void set_auto_warm_start(bool auto_warm_start);
+
+  // LP basis of the last solve, if a continuous model was solved, and
+  // starting basis of the next solve. SCIP does not expose its basis.
+  Basis get_basis() const;
+  void set_basis(Basis const& basis);
+  // Automatically starts each solve from the basis of the previous one
+  // when the model still has the same dimensions.
+  void set_basis_carry_forward(bool carry_forward);
 
   // SCIP requires to know in advance if the problem is to be solved
   // multiple times.
@@ -103,12 +327,38 @@ struct Solver
   static std::map<Backend, std::string> backend_info();
 
   private:
+  Solver(Backend backend, std::shared_ptr<detail::ISolver> const& p_impl);
+
+  // Posts a linear or quadratic constraint as is (scaled if requested or
+  // under autoscale) and returns it as posted.
+  Constr post(Constr const& constr, bool scale);
+  void remove_constrs(std::vector<Constr> const& constrs);
+  void journal_bounds(Var const& v) const;
+
+  SweepStep solve_step(
+    std::function<void(double)> const& set_parameter, std::size_t index, double value
+  );
+  void capture_incumbent();
+  PartialSolution repaired_incumbent() const;
+  bool refine_approximations();
+  void update_approximations();
+  std::optional<Expr> prepare_quadratic(
+    Expr const& e,
+    bool quadratic_is_supported,
+    std::function<bool(Expr const&)> const& is_convex,
+    std::function<std::string()> const& describe
+  );
+
   std::shared_ptr<detail::ISolver> p_impl;
   const Backend m_backend;
   bool m_constraint_autoscale;
   friend struct Var;
   friend struct Constr;
   friend struct IndicatorConstr;
+  friend struct SOSConstr;
+  friend struct GenConstr;
+  friend struct PwlConstr;
+  friend std::vector<Constr> reformulation(std::vector<IndicatorConstr> const&, std::size_t);
   friend struct GurobiVar;
   friend struct ScipVar;
   friend struct GurobiLinearConstr;
@@ -116,6 +366,8 @@ struct Solver
   friend struct GurobiIndicatorConstr;
   friend struct ScipConstr;
   friend struct ScipIndicatorConstr;
+  friend struct ScipSOSConstr;
+  friend struct ScipGenConstr;
   friend struct LpsolveVar;
   friend struct ScipCurrentStateHandle;
 };
@@ -134,6 +386,19 @@ struct ISolver
     std::optional<std::string> const& name
   ) = 0;
 
+  // Variable posted with its objective coefficient and its coefficients
+  // in (posted, linear) constraints.
+  virtual std::shared_ptr<detail::IVar> create_column(
+    Solver const& solver,
+    Var::Type const& type,
+    std::optional<double> const& lb,
+    std::optional<double> const& ub,
+    double obj,
+    std::vector<Constr> const& constrs,
+    std::vector<double> const& coeffs,
+    std::optional<std::string> const& name
+  ) = 0;
+
   virtual std::shared_ptr<detail::IConstr> create_constr(
     Constr::Type const& type, Expr const& e, std::optional<std::string> const& name
   ) = 0;
@@ -144,17 +409,59 @@ struct ISolver
     std::optional<std::string> const& name
   ) = 0;
 
+  virtual std::shared_ptr<detail::ISOSConstr> create_sos_constr(
+    SOSConstr::Type const& type,
+    std::vector<Var> const& vars,
+    std::vector<double> const& weights,
+    std::optional<std::string> const& name
+  ) = 0;
+
+  virtual std::shared_ptr<detail::IGenConstr> create_gen_constr(
+    GenConstr::Type const& type,
+    Var const& resultant,
+    std::vector<Var> const& operands,
+    std::optional<std::string> const& name
+  ) = 0;
+
+  virtual std::shared_ptr<detail::IPwlConstr> create_pwl_constr(
+    Var const& x,
+    Var const& y,
+    std::vector<double> const& xs,
+    std::vector<double> const& ys,
+    std::optional<std::string> const& name
+  ) = 0;
+
   virtual void set_objective(Solver::Sense const& sense, Expr const& e) = 0;
   virtual double get_objective_value() const = 0;
   virtual Solver::Sense get_objective_sense() const = 0;
 
   virtual void add(Constr const& constr) = 0;
   virtual void add(IndicatorConstr const& constr) = 0;
+  virtual void add(SOSConstr const& constr) = 0;
+  virtual void add(GenConstr const& constr) = 0;
+  virtual void add(PwlConstr const& constr) = 0;
 
   virtual void remove(Constr const& constr) = 0;
+  // Removes constraints at once, given in the order they were posted.
+  virtual void remove_constrs(std::vector<Constr> const& constrs);
+
+  virtual void set_coeff(Constr const& constr, Var const& var, double coeff) = 0;
+  virtual void set_rhs(Constr const& constr, double rhs) = 0;
+
+  virtual std::vector<double> get_duals(std::vector<Constr> const& constrs) const = 0;
+  virtual std::vector<double> get_reduced_costs(std::vector<Var> const& vars) const = 0;
 
   virtual void add_lazy_constr_handler(LazyConstrHandler const& constr, bool at_integral_only) = 0;
   virtual std::pair<Solver::Result, bool> solve() = 0;
+
+  // Drops the integrality of the variables, see Solver::solve_relaxation,
+  // until restore_integrality() is called (which does nothing otherwise).
+  virtual void relax_integrality(bool fix_integers) = 0;
+  virtual void restore_integrality() = 0;
+  // Type and bounds of a variable relaxed by relax_integrality, as they
+  // are to be restored (nullopt if it is not relaxed).
+  struct DeclaredDomain { Var::Type type; double lb; double ub; };
+  virtual std::optional<DeclaredDomain> declared_domain(IVar const& var) const = 0;
   virtual void set_non_convex_policy(Solver::NonConvexPolicy policy) = 0;
   virtual void set_indicator_constraint_policy(Solver::IndicatorConstraintPolicy policy);
 
@@ -168,6 +475,9 @@ struct ISolver
   virtual double get_epsilon() const = 0;
 
   virtual bool supports_indicator_constraint(IndicatorConstr const& constr) const = 0;
+  virtual bool supports_sos_constraint(SOSConstr const& constr) const = 0;
+  virtual bool supports_gen_constraint(GenConstr const& constr) const = 0;
+  virtual bool supports_pwl_constraint(PwlConstr const& constr) const = 0;
 
   virtual bool supports_quadratic_constraints() const = 0;
   virtual bool supports_quadratic_objective() const = 0;
@@ -175,20 +485,154 @@ struct ISolver
   virtual double infinity() const = 0;
 
   virtual void set_time_limit(double secs) = 0;
+  // Interrupts the ongoing solve, called from another thread.
+  virtual void interrupt() = 0;
+  // Discards an interruption once the solve it was meant for is over.
+  virtual void clear_interrupt() {}
 
   virtual void dump(std::string const& filename) const = 0;
 
   virtual void set_warm_start(PartialSolution const& partial_solution) = 0;
+  virtual bool supports_warm_start() const { return true; }
+
+  // nullopt if no basis is available.
+  virtual std::optional<Solver::Basis> get_basis() const { return std::nullopt; }
+  // false if the basis does not match the dimensions of the model.
+  virtual bool set_basis(Solver::Basis const& basis);
+
+  // Keep track of a variable (see m_vars) or constraint (see m_constrs),
+  // dropping the destroyed ones once their number may have doubled.
+  void register_var(std::shared_ptr<IVar> const& p_var);
+  void register_constr(std::shared_ptr<IConstr> const& p_constr);
 
   virtual void set_reoptimizing(bool) = 0;
   virtual void setup_reoptimization() = 0;
 
+  // Copy of the model in a new backend instance, see Solver::clone.
+  virtual std::shared_ptr<ISolver> clone() const = 0;
+  // Called on a copy: counterpart of a variable of the original model,
+  // nullptr if there is none.
+  virtual std::shared_ptr<IVar> clone_var(Solver const& solver, IVar const& var) const = 0;
+  // Called on a copy: binds copy, a constraint over the counterparts of
+  // the variables of constr, to the counterpart of constr. Returns false
+  // if there is none (e.g. constr is not posted).
+  virtual bool bind_cloned_constr(Constr const& constr, Constr const& copy) = 0;
+  // Called on a copy once the counterparts are known.
+  virtual void finish_clone(Solver::Remapping const&) {}
+
+  // Flushes model changes buffered by the backend (if any).
+  virtual void update_if_pending() const {}
+
+  Solver::NonConvexPolicy m_non_convex_policy = Solver::NonConvexPolicy::Error;
   Solver::IndicatorConstraintPolicy m_indicator_constraint_policy = 
     Solver::IndicatorConstraintPolicy::ReformulateIfUnsupported;
+  Solver::GeneralConstraintPolicy m_general_constraint_policy = 
+    Solver::GeneralConstraintPolicy::ReformulateIfUnsupported;
+  PwlConstr::Encoding m_pwl_constraint_encoding = PwlConstr::Encoding::Logarithmic;
+  double m_indicator_big_m_threshold = DEFAULT_INDICATOR_BIG_M_THRESHOLD;
+  Solver::IndicatorConstraintStats m_indicator_constraint_stats;
+  detail::LinearizedProducts m_linearized_products;
+  std::vector<detail::BilinearTerm> m_bilinear_terms;
+  std::vector<detail::SquareTerm> m_square_terms;
+  std::size_t m_nr_objective_tangents = 0;
+  std::size_t m_refinement_max_iterations = DEFAULT_REFINEMENT_MAX_ITERATIONS;
+  double m_refinement_tolerance = DEFAULT_REFINEMENT_TOLERANCE;
+  bool m_basis_carry_forward = false;
+  std::optional<Solver::Basis> m_carried_basis;
+  // set by Solver::solve_relaxation until the integrality is restored,
+  // declared_domain being looked up only then.
+  bool m_is_relaxed = false;
+  // set by the cancellation token solving with this solver, from another
+  // thread, so that no further refinement solve is started.
+  std::atomic<bool> m_is_cancelled{false};
+  // variables created so far (without keeping them alive), and the
+  // solution of the last solve if auto warm start is enabled.
+  std::vector<std::weak_ptr<detail::IVar>> m_vars;
+  std::size_t m_nr_vars_at_pruning = 0;
+  // constraints posted as given (neither reformulated nor scaled).
+  std::set<
+    std::weak_ptr<detail::IConstr>, std::owner_less<std::weak_ptr<detail::IConstr>>
+  > m_constrs;
+  std::size_t m_nr_constrs_at_pruning = 0;
+  // last objective set, and the open checkpoints (see Solver::push) with
+  // the original bounds of the variables changed since.
+  std::optional<std::pair<Solver::Sense, Expr>> m_objective;
+  struct Checkpoint
+  {
+    std::map<std::shared_ptr<detail::IVar>, std::pair<double, double>> bounds;
+    std::vector<Constr> constrs;
+    std::optional<std::pair<Solver::Sense, Expr>> objective;
+    bool objective_is_changed = false;
+    detail::LinearizedProducts products;
+    std::size_t nr_bilinear_terms = 0;
+    std::vector<std::size_t> nr_square_points;
+  };
+  std::vector<Checkpoint> m_checkpoints;
+  bool m_auto_warm_start = false;
+  std::map<
+    std::weak_ptr<detail::IVar>, double, std::owner_less<std::weak_ptr<detail::IVar>>
+  > m_incumbent;
 };
 
+// Bounds of a variable whose integrality is dropped: those of its domain,
+// or its value if fixed (value given) and integer, semi-continuous ones
+// being fixed to zero or restricted to their nonzero domain.
+std::pair<double, double> relaxed_bounds(
+  bool is_integer,
+  bool is_semi,
+  double lb,
+  double ub,
+  std::optional<double> const& value,
+  double tolerance
+);
+
 }  // namespace detail
 
 std::ostream& operator<<(std::ostream& os, Solver::Backend const& solver_backend);
 
+#ifdef MIPLIB_WITH_COROUTINES
+// Awaitable solve (see Solver::solve_async): the coroutine is resumed
+// from the thread solving once the result is available.
+struct SolveAwaitable
+{
+  Solver solver;
+  Solver::CancellationToken token;
+  std::pair<Solver::Result, bool> result;
+  // thrown by the solve, rethrown in the coroutine.
+  std::exception_ptr error;
+
+  bool await_ready() const { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle)
+  {
+    std::thread([this, handle]() {
+      try
+      {
+        result = solver.solve(token);
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+      handle.resume();
+    }).detach();
+  }
+
+  std::pair<Solver::Result, bool> await_resume() const
+  {
+    if (error)
+      std::rethrow_exception(error);
+    return result;
+  }
+};
+
+// co_await co_solve(solver, token) within a coroutine.
+inline SolveAwaitable co_solve(
+  Solver const& solver, Solver::CancellationToken const& token = Solver::CancellationToken()
+)
+{
+  return {solver, token, {Solver::Result::Other, false}, nullptr};
+}
+#endif
+
 }  // namespace miplib
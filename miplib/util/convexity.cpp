@@ -0,0 +1,78 @@
+#include "convexity.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace miplib {
+namespace detail {
+
+static double constexpr PSD_TOLERANCE = 1e-9;
+
+/*
+  Q is factorized as L D L' by right-looking sparse elimination without
+  pivoting: a symmetric matrix is positive semidefinite iff the pivots
+  of D are nonnegative and the columns of zero pivots are zero. Only the
+  lower triangle is stored, column-wise, and fill-in is created lazily
+  (separable quadratics have none).
+*/
+bool is_positive_semidefinite(Expr const& e)
+{
+  std::unordered_map<Var, std::size_t> index;
+  auto const index_of = [&](Var const& v) {
+    return index.emplace(v, index.size()).first->second;
+  };
+
+  auto quad_vars_1 = e.quad_vars_1();
+  auto quad_vars_2 = e.quad_vars_2();
+  auto quad_coeffs = e.quad_coeffs();
+
+  // lower[j][i] = Q(i, j) for i >= j.
+  std::vector<std::map<std::size_t, double>> lower;
+  double max_abs = 0;
+  for (std::size_t t = 0; t < quad_coeffs.size(); ++t)
+  {
+    auto const i = index_of(quad_vars_1[t]);
+    auto const j = index_of(quad_vars_2[t]);
+    lower.resize(index.size());
+    if (i == j)
+      lower[i][i] += quad_coeffs[t];
+    else
+      lower[std::min(i, j)][std::max(i, j)] += quad_coeffs[t] / 2;
+    max_abs = std::max(max_abs, std::abs(quad_coeffs[t]));
+  }
+
+  double const tolerance = PSD_TOLERANCE * std::max(1.0, max_abs);
+  for (std::size_t j = 0; j < lower.size(); ++j)
+  {
+    auto const& col = lower[j];
+    auto const it = col.find(j);
+    double const d = it != col.end() ? it->second : 0;
+    if (d < -tolerance)
+      return false;
+
+    if (d <= tolerance)
+    {
+      for (auto const& [i, a_ij]: col)
+        if (i != j and std::abs(a_ij) > tolerance)
+          return false;
+      continue;
+    }
+
+    // Schur complement update of the trailing lower triangle.
+    for (auto const& [i, a_ij]: col)
+    {
+      if (i == j)
+        continue;
+      double const l = a_ij / d;
+      for (auto const& [k, a_kj]: col)
+        if (k != j and k <= i)
+          lower[k][i] -= l * a_kj;
+    }
+  }
+
+  return true;
+}
+
+}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <miplib/expr.hpp>
+
+namespace miplib {
+namespace detail {
+
+// If the symmetric matrix Q of the quadratic part x'Qx of e is
+// positive semidefinite, i.e. if e is convex.
+bool is_positive_semidefinite(Expr const& e);
+
+}
+}
@@ -0,0 +1,164 @@
+#include "linearize.hpp"
+#include <miplib/solver.hpp>
+
+#include <algorithm>
+
+namespace miplib {
+namespace detail {
+
+static bool is_binary(Var const& v)
+{
+  return v.type() == Var::Type::Binary;
+}
+
+static bool is_bounded(Var const& v)
+{
+  double const inf = v.solver().infinity();
+  return v.domain_lb() != -inf and v.domain_ub() != inf;
+}
+
+static bool is_linearizable(Var const& v1, Var const& v2)
+{
+  return
+    (is_binary(v1) and (is_binary(v2) or is_bounded(v2))) or
+    (is_binary(v2) and is_bounded(v1));
+}
+
+/*
+  Products involving a binary variable b have exact linearizations [1]:
+  * b * b = b.
+  * w = b1 * b2 <-> w <= b1 /\ w <= b2 /\ w >= b1 + b2 - 1.
+  * w = b * x, x in [l, u] <->
+      l * b <= w <= u * b /\ x - u * (1 - b) <= w <= x - l * (1 - b).
+
+  [1] F. Glover. Improved linear integer programming formulations of
+      nonlinear integer problems. Management Science, 22(4):455–460, 1975.
+*/
+std::vector<Constr> product_definitions(Var const& w, Var const& b, Var const& x)
+{
+  if (is_binary(x))
+    return {w <= b, w <= x, b + x - 1 <= w};
+
+  double const l = x.domain_lb();
+  double const u = x.domain_ub();
+  return {l * b <= w, w <= u * b, x - u * (1 - b) <= w, w <= x - l * (1 - b)};
+}
+
+static Var product_var(Var const& b, Var const& x)
+{
+  if (is_binary(x))
+    return Var(b.solver(), Var::Type::Continuous, 0, 1);
+  return Var(
+    b.solver(),
+    Var::Type::Continuous,
+    std::min(x.domain_lb(), 0.0),
+    std::max(x.domain_ub(), 0.0)
+  );
+}
+
+// The binary factor b and the other one x of a product.
+static std::pair<Var, Var> factors(std::pair<Var, Var> const& key)
+{
+  if (is_binary(key.first))
+    return key;
+  return {key.second, key.first};
+}
+
+bool is_outdated(std::pair<Var, Var> const& key, LinearizedProduct const& product)
+{
+  if (product.defs.empty())
+    return true;
+  auto const x = factors(key).second;
+  return !is_binary(x) and (x.domain_lb() != product.lb or x.domain_ub() != product.ub);
+}
+
+void redefine(
+  std::pair<Var, Var> const& key,
+  LinearizedProduct& product,
+  std::function<Constr(Constr const&)> const& post
+)
+{
+  auto const [b, x] = factors(key);
+  if (!is_binary(x))
+  {
+    if (!is_bounded(x))
+      throw std::logic_error("Linearized product with an unbounded variable.");
+    // both contain 0, hence the order they are set in does not matter.
+    product.w.set_lb(std::min(x.domain_lb(), 0.0));
+    product.w.set_ub(std::max(x.domain_ub(), 0.0));
+  }
+  product.lb = x.domain_lb();
+  product.ub = x.domain_ub();
+  product.defs.clear();
+  for (auto const& def: product_definitions(product.w, b, x))
+    product.defs.push_back(post(def));
+}
+
+Expr linearize_products(
+  Expr const& e,
+  LinearizedProducts& products,
+  std::function<Constr(Constr const&)> const& post
+)
+{
+  Expr r = e.constant();
+
+  auto linear_vars = e.linear_vars();
+  auto linear_coeffs = e.linear_coeffs();
+  for (std::size_t i = 0; i < linear_vars.size(); ++i)
+    r += linear_coeffs[i] * linear_vars[i];
+
+  auto quad_vars_1 = e.quad_vars_1();
+  auto quad_vars_2 = e.quad_vars_2();
+  auto quad_coeffs = e.quad_coeffs();
+  for (std::size_t i = 0; i < quad_coeffs.size(); ++i)
+  {
+    auto const& v1 = quad_vars_1[i];
+    auto const& v2 = quad_vars_2[i];
+    double const c = quad_coeffs[i];
+
+    if (is_binary(v1) and v1.is_same(v2))
+    {
+      r += c * v1;
+      continue;
+    }
+    if (!is_linearizable(v1, v2))
+    {
+      r += c * v1 * v2;
+      continue;
+    }
+
+    auto const key = std::less<Var>()(v1, v2) ? std::make_pair(v1, v2) : std::make_pair(v2, v1);
+    auto it = products.find(key);
+    if (it == products.end())
+    {
+      auto const& b = is_binary(v1) ? v1 : v2;
+      auto const& x = is_binary(v1) ? v2 : v1;
+      LinearizedProduct product{product_var(b, x), {}, x.domain_lb(), x.domain_ub()};
+      for (auto const& def: product_definitions(product.w, b, x))
+        product.defs.push_back(post(def));
+      it = products.emplace(key, product).first;
+    }
+    r += c * it->second.w;
+  }
+
+  return r;
+}
+
+Expr nonlinearizable_products(Expr const& e)
+{
+  Expr r;
+  auto quad_vars_1 = e.quad_vars_1();
+  auto quad_vars_2 = e.quad_vars_2();
+  auto quad_coeffs = e.quad_coeffs();
+  for (std::size_t i = 0; i < quad_coeffs.size(); ++i)
+  {
+    auto const& v1 = quad_vars_1[i];
+    auto const& v2 = quad_vars_2[i];
+    if (!(is_binary(v1) and v1.is_same(v2)) and !is_linearizable(v1, v2))
+      r += quad_coeffs[i] * v1 * v2;
+  }
+  return r;
+}
+
+}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <miplib/constr.hpp>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace miplib {
+namespace detail {
+
+// Auxiliary variable w of a linearized product, along with the
+// constraints defining it (as posted) and the domain of the bounded
+// factor they were built on.
+struct LinearizedProduct
+{
+  Var w;
+  std::vector<Constr> defs;
+  double lb = 0;
+  double ub = 0;
+};
+
+// Orders products by their (sorted) pair of variables.
+struct ProductLess
+{
+  bool operator()(std::pair<Var, Var> const& p1, std::pair<Var, Var> const& p2) const
+  {
+    std::less<Var> const less;
+    if (less(p1.first, p2.first))
+      return true;
+    if (less(p2.first, p1.first))
+      return false;
+    return less(p1.second, p2.second);
+  }
+};
+
+using LinearizedProducts = std::map<std::pair<Var, Var>, LinearizedProduct, ProductLess>;
+
+// Constraints defining w = b * x for a binary b and a binary or bounded x.
+std::vector<Constr> product_definitions(Var const& w, Var const& b, Var const& x);
+
+// Replaces the products of a binary variable with a binary or a bounded
+// variable by auxiliary variables; the other quadratic terms are left
+// untouched. The auxiliary variables of the products registered in
+// products are reused, and the new ones registered, their (linear)
+// definitions being posted through post (returning them as posted).
+// Returns the resulting expression.
+Expr linearize_products(
+  Expr const& e,
+  LinearizedProducts& products,
+  std::function<Constr(Constr const&)> const& post
+);
+
+// Whether the definitions of the product of the given (sorted) pair of
+// variables were built on another domain of its bounded factor than its
+// current one, or are missing.
+bool is_outdated(std::pair<Var, Var> const& key, LinearizedProduct const& product);
+
+// Posts the definitions of the product through post over the current
+// domain of its bounded factor, its previous ones having been removed;
+// the bounds of w follow.
+void redefine(
+  std::pair<Var, Var> const& key,
+  LinearizedProduct& product,
+  std::function<Constr(Constr const&)> const& post
+);
+
+// The quadratic terms linearize_products leaves untouched, i.e. the
+// quadratic part of its result, without creating auxiliary variables.
+Expr nonlinearizable_products(Expr const& e);
+
+}
+}
@@ -0,0 +1,204 @@
+#include "mccormick.hpp"
+#include "linearize.hpp"
+#include <miplib/solver.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace miplib {
+namespace detail {
+
+static bool is_bounded(Var const& v)
+{
+  double const inf = v.solver().infinity();
+  return v.domain_lb() != -inf and v.domain_ub() != inf;
+}
+
+/*
+  For x in [xl, xu] and y in [yl, yu], (x - xl) * (y - yl) >= 0 and
+  similar products give the McCormick envelope [1] of w = x * y:
+    xl * y + yl * x - xl * yl <= w <= xu * y + yl * x - xu * yl
+    xu * y + yu * x - xu * yu <= w <= xl * y + yu * x - xl * yu.
+  Partitioning [xl, xu] at breakpoints p_0 < ... < p_K and selecting the
+  interval with binaries l_k (sum l_k = 1) gives the piecewise envelope
+  [2], with xl = sum p_{k-1} * l_k, xu = sum p_k * l_k and the products
+  l_k * y linearized exactly.
+
+  [1] G. P. McCormick. Computability of global solutions to factorable
+      nonconvex programs: Part I. Mathematical Programming, 10:147–175, 1976.
+  [2] M. L. Bergamini, P. Aguirre, I. Grossmann. Logic-based outer
+      approximation for globally optimal synthesis of process networks.
+      Computers & Chemical Engineering, 29(9):1914–1933, 2005.
+*/
+std::vector<Constr> mccormick_envelope(BilinearTerm& term)
+{
+  auto const& x = term.x;
+  auto const& y = term.y;
+  auto const& w = term.w;
+  auto const& ps = term.breakpoints;
+  double const yl = y.domain_lb();
+  double const yu = y.domain_ub();
+
+  std::vector<Constr> r;
+  Expr xl, xu, xl_y, xu_y;
+  if (ps.size() <= 2)
+  {
+    xl = ps.front();
+    xu = ps.back();
+    xl_y = ps.front() * y;
+    xu_y = ps.back() * y;
+  }
+  else
+  {
+    // the selectors of a previous partition are reused, its envelope
+    // being removed.
+    auto& selectors = term.selectors;
+    while (selectors.size() + 1 < ps.size())
+      selectors.emplace_back(
+        Var(x.solver(), Var::Type::Binary),
+        Var(x.solver(), Var::Type::Continuous, std::min(yl, 0.0), std::max(yu, 0.0))
+      );
+
+    Expr sum_l;
+    for (std::size_t k = 1; k < ps.size(); ++k)
+    {
+      auto const& [l, l_y] = selectors[k - 1];
+      auto const defs = product_definitions(l_y, l, y);
+      r.insert(r.end(), defs.begin(), defs.end());
+      sum_l += l;
+      xl += ps[k - 1] * l;
+      xu += ps[k] * l;
+      xl_y += ps[k - 1] * l_y;
+      xu_y += ps[k] * l_y;
+    }
+    r.push_back(sum_l == 1);
+    r.push_back(xl <= x);
+    r.push_back(x <= xu);
+  }
+
+  r.push_back(xl_y + yl * x - yl * xl <= w);
+  r.push_back(xu_y + yu * x - yu * xu <= w);
+  r.push_back(w <= xu_y + yl * x - yl * xu);
+  r.push_back(w <= xl_y + yu * x - yu * xl);
+  return r;
+}
+
+// Bounds of x * y over the domains of x and y.
+static std::pair<double, double> product_bounds(Var const& x, Var const& y)
+{
+  double const l1 = x.domain_lb(), u1 = x.domain_ub();
+  double const l2 = y.domain_lb(), u2 = y.domain_ub();
+  auto const corners = {l1 * l2, l1 * u2, u1 * l2, u1 * u2};
+  double lb = std::min(corners);
+  double ub = std::max(corners);
+  if (x.is_same(y))
+    lb = (l1 <= 0 and u1 >= 0) ? 0 : std::min(l1 * l1, u1 * u1);
+  return {lb, ub};
+}
+
+bool is_outdated(BilinearTerm const& term)
+{
+  auto const& ps = term.breakpoints;
+  return
+    ps.front() != term.x.domain_lb() or ps.back() != term.x.domain_ub() or
+    term.y_lb != term.y.domain_lb() or term.y_ub != term.y.domain_ub();
+}
+
+void reset(BilinearTerm& term)
+{
+  if (!is_bounded(term.x) or !is_bounded(term.y))
+    throw std::logic_error("McCormick relaxation requires bounded variables.");
+
+  // the bounds are set in an order keeping them consistent.
+  auto const [lb, ub] = product_bounds(term.x, term.y);
+  if (lb > term.w.ub())
+  {
+    term.w.set_ub(ub);
+    term.w.set_lb(lb);
+  }
+  else
+  {
+    term.w.set_lb(lb);
+    term.w.set_ub(ub);
+  }
+
+  // the selectors are dropped, the bounds of the products l_k * y being
+  // those of y.
+  term.breakpoints = {term.x.domain_lb(), term.x.domain_ub()};
+  term.selectors.clear();
+  term.y_lb = term.y.domain_lb();
+  term.y_ub = term.y.domain_ub();
+}
+
+Expr relax_bilinear_terms(
+  Expr const& e,
+  std::vector<BilinearTerm>& terms,
+  std::function<Constr(Constr const&)> const& post
+)
+{
+  Expr r = e.constant();
+
+  auto linear_vars = e.linear_vars();
+  auto linear_coeffs = e.linear_coeffs();
+  for (std::size_t i = 0; i < linear_vars.size(); ++i)
+    r += linear_coeffs[i] * linear_vars[i];
+
+  auto quad_vars_1 = e.quad_vars_1();
+  auto quad_vars_2 = e.quad_vars_2();
+  auto quad_coeffs = e.quad_coeffs();
+  for (std::size_t i = 0; i < quad_coeffs.size(); ++i)
+  {
+    auto const& v1 = quad_vars_1[i];
+    auto const& v2 = quad_vars_2[i];
+
+    if (!is_bounded(v1) or !is_bounded(v2))
+      throw std::logic_error("McCormick relaxation requires bounded variables.");
+
+    auto it = std::find_if(terms.begin(), terms.end(), [&](auto const& t) {
+      return
+        (t.x.is_same(v1) and t.y.is_same(v2)) or
+        (t.x.is_same(v2) and t.y.is_same(v1));
+    });
+
+    if (it == terms.end())
+    {
+      auto const [lb, ub] = product_bounds(v1, v2);
+      Var w(v1.solver(), Var::Type::Continuous, lb, ub);
+      terms.push_back({
+        v1, v2, w, {v1.domain_lb(), v1.domain_ub()}, {}, {}, v2.domain_lb(), v2.domain_ub()
+      });
+      auto& term = terms.back();
+      for (auto const& c: mccormick_envelope(term))
+        term.envelope.push_back(post(c));
+      it = std::prev(terms.end());
+    }
+
+    r += quad_coeffs[i] * it->w;
+  }
+
+  return r;
+}
+
+bool refine(BilinearTerm& term, double tolerance)
+{
+  double const x = term.x.value();
+  double const xy = x * term.y.value();
+  if (std::abs(term.w.value() - xy) <= tolerance * std::max(1.0, std::abs(xy)))
+    return false;
+
+  // the envelope is exact at the breakpoints, hence x lies within an
+  // interval; it is split at its midpoint if x is close to its ends.
+  auto& ps = term.breakpoints;
+  auto it = std::upper_bound(ps.begin(), ps.end(), x);
+  if (it == ps.begin() or it == ps.end())
+    return false;
+  double const lo = *std::prev(it);
+  double const hi = *it;
+  double const split =
+    (x - lo < 0.1 * (hi - lo) or hi - x < 0.1 * (hi - lo)) ? (lo + hi) / 2 : x;
+  ps.insert(it, split);
+  return true;
+}
+
+}
+}
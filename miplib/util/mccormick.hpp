@@ -0,0 +1,56 @@
+#pragma once
+
+#include <miplib/constr.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace miplib {
+namespace detail {
+
+// Auxiliary variable w relaxing the product x * y, the domain of x
+// being partitioned at the given (sorted) breakpoints. The envelope
+// currently posted is kept so that a refined one replaces it, along with
+// the domain of y it was built on.
+struct BilinearTerm
+{
+  Var x;
+  Var y;
+  Var w;
+  std::vector<double> breakpoints;
+  // binaries l_k selecting the intervals and the products l_k * y.
+  std::vector<std::pair<Var, Var>> selectors;
+  std::vector<Constr> envelope;
+  double y_lb = 0;
+  double y_ub = 0;
+};
+
+// Piecewise McCormick envelope of w = x * y over the partition of the
+// domain of x (a single interval gives the classical envelope), creating
+// the selectors it lacks. The returned constraints are linear.
+std::vector<Constr> mccormick_envelope(BilinearTerm& term);
+
+// Whether the domain of x or y differs from the one the partition and
+// the envelope of the term were built on.
+bool is_outdated(BilinearTerm const& term);
+
+// Resets the partition of the term to the current domain of x, the
+// bounds of w following; its envelope is to be posted anew.
+void reset(BilinearTerm& term);
+
+// Replaces the products of bounded variables by auxiliary variables
+// registered in terms (those of products seen before are reused), the
+// envelopes of the new terms being posted through post (returning them
+// as posted). Returns the resulting expression.
+Expr relax_bilinear_terms(
+  Expr const& e,
+  std::vector<BilinearTerm>& terms,
+  std::function<Constr(Constr const&)> const& post
+);
+
+// Splits the partition of the term around the current value of x if
+// |w - x * y| exceeds the tolerance. Returns if it did so.
+bool refine(BilinearTerm& term, double tolerance);
+
+}
+}
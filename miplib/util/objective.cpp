@@ -0,0 +1,59 @@
+#include "objective.hpp"
+
+namespace miplib {
+namespace detail {
+
+std::optional<std::vector<std::pair<std::shared_ptr<IVar>, double>>>
+ObjectiveCoefficients::update(Expr const& e)
+{
+  bool const was_valid = m_is_valid;
+  auto const old_coeffs = m_coeffs;
+  reset(e);
+  if (!was_valid)
+    return std::nullopt;
+
+  std::vector<std::pair<std::shared_ptr<IVar>, double>> r;
+  for (auto const& [p_var, coeff]: old_coeffs)
+  {
+    if (coeff == 0 or m_coeffs.find(p_var) != m_coeffs.end())
+      continue;
+    if (p_var.expired())
+      return std::nullopt;
+    r.emplace_back(p_var.lock(), 0);
+  }
+
+  auto const linear_vars = e.linear_vars();
+  auto const linear_coeffs = e.linear_coeffs();
+  for (std::size_t i = 0; i < linear_vars.size(); ++i)
+  {
+    auto it = old_coeffs.find(linear_vars[i].p_impl);
+    if (it == old_coeffs.end() or it->second != linear_coeffs[i])
+      r.emplace_back(linear_vars[i].p_impl, linear_coeffs[i]);
+  }
+  return r;
+}
+
+void ObjectiveCoefficients::reset(Expr const& e)
+{
+  m_coeffs.clear();
+  m_is_valid = true;
+  auto const linear_vars = e.linear_vars();
+  auto const linear_coeffs = e.linear_coeffs();
+  for (std::size_t i = 0; i < linear_vars.size(); ++i)
+    m_coeffs[linear_vars[i].p_impl] = linear_coeffs[i];
+}
+
+void ObjectiveCoefficients::record(std::shared_ptr<IVar> const& p_var, double coeff)
+{
+  if (m_is_valid and coeff != 0)
+    m_coeffs[p_var] = coeff;
+}
+
+void ObjectiveCoefficients::invalidate()
+{
+  m_coeffs.clear();
+  m_is_valid = false;
+}
+
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <miplib/expr.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace miplib {
+namespace detail {
+
+// Linear objective coefficients posted to a backend, so that a new
+// objective is posted as the coefficients that changed. Variables are
+// not kept alive.
+struct ObjectiveCoefficients
+{
+  // Coefficients of e that differ from the posted ones, along with zeros
+  // for the posted variables missing from e. They are then the posted ones.
+  // nullopt if a posted variable can no longer be reset (it was destroyed)
+  // or if the posted coefficients are unknown: the whole objective is to
+  // be posted.
+  std::optional<std::vector<std::pair<std::shared_ptr<IVar>, double>>> update(
+    Expr const& e
+  );
+
+  // Records the coefficients of e as posted (e.g. after posting the whole
+  // objective).
+  void reset(Expr const& e);
+
+  // Records the coefficient of a variable posted along with it (e.g. a
+  // column added with an objective coefficient).
+  void record(std::shared_ptr<IVar> const& p_var, double coeff);
+
+  // Marks the posted coefficients as unknown (e.g. in a copied model).
+  void invalidate();
+
+  private:
+  std::map<std::weak_ptr<IVar>, double, std::owner_less<std::weak_ptr<IVar>>> m_coeffs;
+  bool m_is_valid = true;
+};
+
+}
+}
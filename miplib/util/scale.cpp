@@ -105,6 +105,14 @@ Constr scale_gm(Constr const& constr, double skip_lb, double skip_ub, bool ignor
   if (constr.type() == Constr::Equal)
     return scaling_factor * constr.expr() == 0;
   else
+  if (constr.type() == Constr::Range)
+    return Constr(
+      constr.expr().solver(),
+      scaling_factor * constr.expr(),
+      scaling_factor * constr.width(),
+      constr.name()
+    );
+  else
   {
     assert(constr.type() == Constr::LessEqual); 
     return scaling_factor * constr.expr() <= 0;
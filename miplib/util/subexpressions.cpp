@@ -0,0 +1,149 @@
+#include "subexpressions.hpp"
+#include <miplib/solver.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <unordered_map>
+
+namespace miplib {
+namespace detail {
+
+/*
+  Terms (variable, coefficient) are numbered and each row is the set of
+  its term ids, with an inverted index from terms to rows. Greedily, the
+  largest term set a row shares with another row is looked up through
+  the index; if the k rows containing these m terms give k * m > k + m + 1,
+  i.e. if nonzeros are saved, the terms are replaced in these rows by a
+  single term of a new variable w, defined by w = sum of the terms.
+*/
+std::vector<Constr> extract_common_subexpressions(
+  std::vector<Constr> const& constrs, std::size_t min_size
+)
+{
+  if (constrs.empty())
+    return {};
+
+  std::vector<std::pair<Var, double>> terms;
+  std::unordered_map<Var, std::unordered_map<double, std::size_t>> term_ids;
+  auto const term_id = [&](Var const& v, double c) {
+    auto [it, inserted] = term_ids[v].emplace(c, terms.size());
+    if (inserted)
+      terms.emplace_back(v, c);
+    return it->second;
+  };
+
+  std::vector<std::set<std::size_t>> rows(constrs.size());
+  std::vector<std::set<std::size_t>> rows_of_term;
+  for (std::size_t r = 0; r < constrs.size(); ++r)
+  {
+    auto const e = constrs[r].expr();
+    auto const linear_vars = e.linear_vars();
+    auto const linear_coeffs = e.linear_coeffs();
+    for (std::size_t i = 0; i < linear_vars.size(); ++i)
+    {
+      auto const t = term_id(linear_vars[i], linear_coeffs[i]);
+      rows_of_term.resize(terms.size());
+      rows[r].insert(t);
+      rows_of_term[t].insert(r);
+    }
+  }
+
+  Solver const& solver = constrs.front().expr().solver();
+  std::vector<Constr> defs;
+  for (std::size_t r = 0; r < rows.size(); ++r)
+  {
+    while (true)
+    {
+      // the row sharing the most terms with r.
+      std::unordered_map<std::size_t, std::size_t> overlaps;
+      for (auto t: rows[r])
+        for (auto s: rows_of_term[t])
+          if (s != r)
+            ++overlaps[s];
+      auto const best = std::max_element(
+        overlaps.begin(),
+        overlaps.end(),
+        [](auto const& a, auto const& b) {
+          return a.second < b.second or (a.second == b.second and a.first > b.first);
+        }
+      );
+      if (best == overlaps.end() or best->second < std::max<std::size_t>(min_size, 2))
+        break;
+
+      std::vector<std::size_t> shared;
+      std::set_intersection(
+        rows[r].begin(), rows[r].end(),
+        rows[best->first].begin(), rows[best->first].end(),
+        std::back_inserter(shared)
+      );
+
+      std::set<std::size_t> sharing = rows_of_term[shared.front()];
+      for (auto t: shared)
+      {
+        std::set<std::size_t> both;
+        std::set_intersection(
+          sharing.begin(), sharing.end(),
+          rows_of_term[t].begin(), rows_of_term[t].end(),
+          std::inserter(both, both.end())
+        );
+        sharing.swap(both);
+      }
+
+      std::size_t const k = sharing.size();
+      std::size_t const m = shared.size();
+      if (k * m <= k + m + 1)
+        break;
+
+      Expr sum;
+      for (auto t: shared)
+        sum += terms[t].second * terms[t].first;
+      auto const [lb, ub] = sum.bounds();
+      Var w(
+        solver,
+        sum.must_be_integer() ? Var::Type::Integer : Var::Type::Continuous,
+        lb,
+        ub
+      );
+      defs.push_back(sum == w);
+
+      auto const w_id = term_id(w, 1);
+      rows_of_term.resize(terms.size());
+      for (auto s: sharing)
+      {
+        for (auto t: shared)
+        {
+          rows[s].erase(t);
+          rows_of_term[t].erase(s);
+        }
+        rows[s].insert(w_id);
+        rows_of_term[w_id].insert(s);
+      }
+    }
+  }
+
+  std::vector<Constr> r;
+  for (std::size_t i = 0; i < constrs.size(); ++i)
+  {
+    auto const& constr = constrs[i];
+    auto const e = constr.expr();
+    Expr rewritten = e.constant();
+    for (auto t: rows[i])
+      rewritten += terms[t].second * terms[t].first;
+    auto const quad_vars_1 = e.quad_vars_1();
+    auto const quad_vars_2 = e.quad_vars_2();
+    auto const quad_coeffs = e.quad_coeffs();
+    for (std::size_t j = 0; j < quad_coeffs.size(); ++j)
+      rewritten += quad_coeffs[j] * quad_vars_1[j] * quad_vars_2[j];
+
+    if (constr.type() == Constr::Range)
+      r.push_back(Constr(solver, rewritten, constr.width(), constr.name()));
+    else
+      r.push_back(Constr(solver, constr.type(), rewritten, constr.name()));
+  }
+  r.insert(r.end(), defs.begin(), defs.end());
+  return r;
+}
+
+}
+}
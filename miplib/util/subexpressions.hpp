@@ -0,0 +1,15 @@
+#pragma once
+
+#include <miplib/constr.hpp>
+
+#include <vector>
+
+namespace miplib {
+namespace detail {
+
+std::vector<Constr> extract_common_subexpressions(
+  std::vector<Constr> const& constrs, std::size_t min_size
+);
+
+}
+}
@@ -0,0 +1,90 @@
+#include "tangents.hpp"
+#include <miplib/solver.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace miplib {
+namespace detail {
+
+Constr tangent(SquareTerm const& term, double p)
+{
+  return 2 * p * term.x - p * p <= term.t;
+}
+
+/*
+  x * x being convex, its tangents are below it and t >= max_k tangent_k
+  is an outer approximation that only needs continuous variables and is
+  exact at the tangent points (Kelley's cutting planes). Minimizing
+  c * t with c > 0 (or maximizing with c < 0) drives t down to it.
+*/
+Expr approximate_squares(
+  Expr const& e,
+  std::size_t nr_tangents,
+  std::vector<SquareTerm>& terms,
+  std::function<Constr(Constr const&)> const& post
+)
+{
+  Expr r = e.constant();
+
+  auto linear_vars = e.linear_vars();
+  auto linear_coeffs = e.linear_coeffs();
+  for (std::size_t i = 0; i < linear_vars.size(); ++i)
+    r += linear_coeffs[i] * linear_vars[i];
+
+  auto quad_vars_1 = e.quad_vars_1();
+  auto quad_vars_2 = e.quad_vars_2();
+  auto quad_coeffs = e.quad_coeffs();
+  for (std::size_t i = 0; i < quad_coeffs.size(); ++i)
+  {
+    auto const& x = quad_vars_1[i];
+    if (!x.is_same(quad_vars_2[i]))
+      throw std::logic_error("Tangent approximation requires a separable quadratic.");
+
+    double const inf = x.solver().infinity();
+    double const l = x.domain_lb();
+    double const u = x.domain_ub();
+    if (l == -inf or u == inf)
+      throw std::logic_error("Tangent approximation requires bounded variables.");
+
+    // the tangents of a term hold whatever the bounds of x, only the
+    // bound of t may have to follow them.
+    auto it = std::find_if(terms.begin(), terms.end(), [&](auto const& term) {
+      return term.x.is_same(x);
+    });
+    if (it != terms.end())
+    {
+      it->is_active = true;
+      if (it->t.ub() < std::max(l * l, u * u))
+        it->t.set_ub(std::max(l * l, u * u));
+      r += quad_coeffs[i] * it->t;
+      continue;
+    }
+
+    Var t(x.solver(), Var::Type::Continuous, 0, std::max(l * l, u * u));
+    SquareTerm term{x, t, {}, true};
+    for (std::size_t k = 0; k < std::max<std::size_t>(nr_tangents, 1); ++k)
+    {
+      double const p = nr_tangents > 1 ? l + k * (u - l) / (nr_tangents - 1) : (l + u) / 2;
+      term.points.push_back(p);
+      post(tangent(term, p));
+    }
+    terms.push_back(term);
+
+    r += quad_coeffs[i] * t;
+  }
+
+  return r;
+}
+
+bool refine(SquareTerm& term, double tolerance)
+{
+  double const x = term.x.value();
+  if (x * x - term.t.value() <= tolerance * std::max(1.0, x * x))
+    return false;
+  term.points.push_back(x);
+  return true;
+}
+
+}
+}
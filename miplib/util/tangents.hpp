@@ -0,0 +1,41 @@
+#pragma once
+
+#include <miplib/constr.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace miplib {
+namespace detail {
+
+// Auxiliary variable t bounding x * x from above through the tangents
+// of x * x at the given points. Terms are kept across objectives, only
+// those of the current one being active (i.e. refined).
+struct SquareTerm
+{
+  Var x;
+  Var t;
+  std::vector<double> points;
+  bool is_active;
+};
+
+// t >= 2 * p * x - p * p.
+Constr tangent(SquareTerm const& term, double p);
+
+// Replaces the squares c * x * x of a separable quadratic by c * t,
+// reusing the terms of x registered in terms (and activating them) or
+// registering new ones with nr_tangents tangents spread over the bounds
+// of x, posted through post. Returns the resulting expression.
+Expr approximate_squares(
+  Expr const& e,
+  std::size_t nr_tangents,
+  std::vector<SquareTerm>& terms,
+  std::function<Constr(Constr const&)> const& post
+);
+
+// Adds the current value of x to the tangent points if x * x - t
+// exceeds the tolerance. Returns if it did so.
+bool refine(SquareTerm& term, double tolerance);
+
+}
+}
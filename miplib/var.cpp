@@ -1,6 +1,7 @@
 #include "var.hpp"
 #include "solver.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -15,7 +16,9 @@ Var::Var(
   std::optional<std::string> const& name
 ):
   p_impl(solver.p_impl->create_var(solver, type, lb, ub, name))
-{}
+{
+  solver.p_impl->register_var(p_impl);
+}
 
 
 Var::Var(Solver const& solver, Var::Type const& type, std::string const& name):
@@ -66,9 +69,13 @@ double Var::value() const
 }
 
 
+// Variables relaxed by Solver::solve_relaxation report their declared
+// type and bounds.
 Var::Type Var::type() const
 {
-  return p_impl->type();
+  auto const& impl = *solver().p_impl;
+  auto const domain = impl.m_is_relaxed ? impl.declared_domain(*p_impl) : std::nullopt;
+  return domain.has_value() ? domain->type : p_impl->type();
 }
 
 
@@ -80,21 +87,58 @@ Solver const& Var::solver() const
 
 double Var::lb() const
 {
-  return p_impl->lb();
+  auto const& impl = *solver().p_impl;
+  auto const domain = impl.m_is_relaxed ? impl.declared_domain(*p_impl) : std::nullopt;
+  return domain.has_value() ? domain->lb : p_impl->lb();
 }
 
 double Var::ub() const
 {
-  return p_impl->ub(); 
+  auto const& impl = *solver().p_impl;
+  auto const domain = impl.m_is_relaxed ? impl.declared_domain(*p_impl) : std::nullopt;
+  return domain.has_value() ? domain->ub : p_impl->ub();
+}
+
+static bool is_semi(Var::Type const& type)
+{
+  return type == Var::Type::SemiContinuous or type == Var::Type::SemiInteger;
 }
 
+double Var::domain_lb() const
+{
+  double const lb = this->lb();
+  return is_semi(type()) ? std::min(lb, 0.0) : lb;
+}
+
+double Var::domain_ub() const
+{
+  double const ub = this->ub();
+  return is_semi(type()) ? std::max(ub, 0.0) : ub;
+}
+
+// A bound change ends the relaxation of the last solve_relaxation, whose
+// bounds would otherwise be restored over it.
 void Var::set_lb(double new_lb)
 {
+  auto& impl = *solver().p_impl;
+  if (impl.m_is_relaxed)
+  {
+    impl.restore_integrality();
+    impl.m_is_relaxed = false;
+  }
+  solver().journal_bounds(*this);
   p_impl->set_lb(new_lb);
 }
 
 void Var::set_ub(double new_ub)
 {
+  auto& impl = *solver().p_impl;
+  if (impl.m_is_relaxed)
+  {
+    impl.restore_integrality();
+    impl.m_is_relaxed = false;
+  }
+  solver().journal_bounds(*this);
   p_impl->set_ub(new_ub);
 }
 
@@ -103,6 +147,11 @@ void Var::set_hint(double v)
   p_impl->set_hint(v);
 }
 
+double Var::reduced_cost() const
+{
+  return solver().reduced_costs({*this}).front();
+}
+
 std::ostream& operator<<(std::ostream& os, Var const& v)
 {
   os << v.id();
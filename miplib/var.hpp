@@ -17,7 +17,9 @@ struct IVar;
 
 struct Var
 {
-  enum class Type { Continuous, Binary, Integer };
+  // Semi-continuous (semi-integer) variables take either the value zero
+  // or a continuous (integer) value within their bounds.
+  enum class Type { Continuous, Binary, Integer, SemiContinuous, SemiInteger };
 
   Var(
     Solver const& solver,
@@ -49,14 +51,25 @@ struct Var
   double lb() const;
   double ub() const;
 
+  // bounds of the values the variable can take (those of semi-continuous
+  // and semi-integer variables are extended to include zero).
+  double domain_lb() const;
+  double domain_ub() const;
+
   void set_lb(double new_lb);
   void set_ub(double new_ub);
 
   void set_hint(double v);
 
+  // see Solver::reduced_costs.
+  double reduced_cost() const;
+
   std::shared_ptr<detail::IVar> p_impl;
 
   private:
+  explicit Var(std::shared_ptr<detail::IVar> const& p_impl): p_impl(p_impl) {}
+
+  friend struct Solver;
   friend struct std::hash<Var>;
   friend struct boost::hash<Var>;
   friend struct std::less<Var>;
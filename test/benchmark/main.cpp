@@ -0,0 +1,3 @@
+// This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_MAIN 
+#include <catch2/catch.hpp>
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+
+#include <miplib/solver.hpp>
+
+#include <random>
+
+#include <fmt/ostream.h>
+
+using namespace miplib;
+
+static std::size_t constexpr NR_ITEMS = 40;
+static std::size_t constexpr NR_SOLVES = 10;
+
+// Knapsack problem whose profits are perturbed by up to 10% between solves.
+static double solve_objective_sequence(bool reoptimizing)
+{
+  Solver solver(Solver::Backend::Scip, false);
+  solver.set_reoptimizing(reoptimizing);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> weight(1, 10);
+  std::uniform_real_distribution<double> perturbation(0.9, 1.1);
+
+  std::vector<Var> xs;
+  std::vector<double> profits;
+  Expr total_weight;
+  for (std::size_t i = 0; i < NR_ITEMS; ++i)
+  {
+    xs.emplace_back(solver, Var::Type::Binary);
+    profits.push_back(weight(gen));
+    total_weight += weight(gen) * xs.back();
+  }
+  solver.add(total_weight <= 5 * NR_ITEMS / 2);
+
+  double r = 0;
+  for (std::size_t k = 0; k < NR_SOLVES; ++k)
+  {
+    Expr profit;
+    for (std::size_t i = 0; i < NR_ITEMS; ++i)
+      profit += profits[i] * perturbation(gen) * xs[i];
+    solver.maximize(profit);
+    r += solver.get_objective_value();
+  }
+  return r;
+}
+
+// Same, the profits of pairs of consecutive items being reduced: only
+// the linear part of the quadratic objective changes.
+static double solve_quadratic_objective_sequence(bool reoptimizing)
+{
+  Solver solver(Solver::Backend::Scip, false);
+  solver.set_reoptimizing(reoptimizing);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> weight(1, 10);
+  std::uniform_real_distribution<double> perturbation(0.9, 1.1);
+
+  std::vector<Var> xs;
+  std::vector<double> profits;
+  Expr total_weight;
+  for (std::size_t i = 0; i < NR_ITEMS; ++i)
+  {
+    xs.emplace_back(solver, Var::Type::Binary);
+    profits.push_back(weight(gen));
+    total_weight += weight(gen) * xs.back();
+  }
+  solver.add(total_weight <= 5 * NR_ITEMS / 2);
+
+  Expr penalty;
+  for (std::size_t i = 1; i < NR_ITEMS; ++i)
+    penalty += xs[i - 1] * xs[i];
+
+  double r = 0;
+  for (std::size_t k = 0; k < NR_SOLVES; ++k)
+  {
+    Expr profit = -penalty;
+    for (std::size_t i = 0; i < NR_ITEMS; ++i)
+      profit += profits[i] * perturbation(gen) * xs[i];
+    solver.maximize(profit);
+    r += solver.get_objective_value();
+  }
+  return r;
+}
+
+// Knapsack problem whose items are excluded one at a time.
+static double solve_bound_sequence(bool reoptimizing)
+{
+  Solver solver(Solver::Backend::Scip, false);
+  solver.set_reoptimizing(reoptimizing);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> weight(1, 10);
+
+  std::vector<Var> xs;
+  Expr profit, total_weight;
+  for (std::size_t i = 0; i < NR_ITEMS; ++i)
+  {
+    xs.emplace_back(solver, Var::Type::Binary);
+    profit += weight(gen) * xs.back();
+    total_weight += weight(gen) * xs.back();
+  }
+  solver.add(total_weight <= 5 * NR_ITEMS / 2);
+  solver.set_objective(Solver::Sense::Maximize, profit);
+
+  double r = 0;
+  for (std::size_t k = 0; k < NR_SOLVES; ++k)
+  {
+    solver.solve();
+    r += solver.get_objective_value();
+    xs[k].set_ub(0);
+  }
+  return r;
+}
+
+TEST_CASE("SCIP reoptimization", "[!benchmark]")
+{
+  if (!Solver::backend_is_available(Solver::Backend::Scip))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Solver::Backend::Scip));
+    return;
+  }
+
+  BENCHMARK("objective changes, from scratch")
+  {
+    return solve_objective_sequence(false);
+  };
+  BENCHMARK("objective changes, reoptimizing")
+  {
+    return solve_objective_sequence(true);
+  };
+  BENCHMARK("quadratic objective changes, from scratch")
+  {
+    return solve_quadratic_objective_sequence(false);
+  };
+  BENCHMARK("quadratic objective changes, reoptimizing")
+  {
+    return solve_quadratic_objective_sequence(true);
+  };
+  BENCHMARK("bound tightenings, from scratch")
+  {
+    return solve_bound_sequence(false);
+  };
+  BENCHMARK("bound tightenings, reoptimizing")
+  {
+    return solve_bound_sequence(true);
+  };
+}
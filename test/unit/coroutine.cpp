@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <miplib/solver.hpp>
+
+#include <future>
+
+#include <fmt/ostream.h>
+
+#ifdef MIPLIB_WITH_COROUTINES
+
+namespace {
+
+// Coroutine run eagerly up to its first suspension, its frame being
+// destroyed once it returns.
+struct Task
+{
+  struct promise_type
+  {
+    Task get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+Task solve_into(
+  miplib::Solver solver,
+  miplib::Solver::CancellationToken token,
+  std::promise<std::pair<miplib::Solver::Result, bool>>& result
+)
+{
+  try
+  {
+    result.set_value(co_await miplib::co_solve(solver, token));
+  }
+  catch (...)
+  {
+    result.set_exception(std::current_exception());
+  }
+}
+
+}  // namespace
+
+TEMPLATE_TEST_CASE_SIG(
+  "Coroutine solve", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  solver.add(6 * x + 4 * y <= 24);
+  solver.add(x + 2 * y <= 6);
+  solver.set_objective(Solver::Sense::Maximize, 5 * x + 4 * y);
+
+  std::promise<std::pair<Solver::Result, bool>> result;
+  solve_into(solver, Solver::CancellationToken(), result);
+  auto [r, has_solution] = result.get_future().get();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  // a cancelled token interrupts the solve.
+  Solver::CancellationToken token;
+  token.cancel();
+  std::promise<std::pair<Solver::Result, bool>> cancelled_result;
+  solve_into(solver, token, cancelled_result);
+  std::tie(r, has_solution) = cancelled_result.get_future().get();
+  REQUIRE(r == Solver::Result::Interrupted);
+  REQUIRE(!has_solution);
+}
+
+#endif
@@ -423,5 +423,26 @@ TEMPLATE_TEST_CASE_SIG(
     REQUIRE(fmt::format("{}", r[0]) == "x + z1 + z2 - 5 <= 0");
     REQUIRE(fmt::format("{}", r[1]) == "-x + z1 + z2 + 1 <= 0");
   }
+
+  SECTION("Batch reformulation")
+  {
+    Var x(solver, Var::Type::Integer, 2, 4, "x");
+    std::vector<IndicatorConstr> constrs;
+    std::vector<std::string> expected;
+    for (int i = 2; i <= 4; ++i)
+    {
+      constrs.push_back(z >> (x == i));
+      for (auto const& c: constrs.back().reformulation())
+        expected.push_back(fmt::format("{}", c));
+    }
+
+    for (std::size_t nr_threads: {1, 2, 8})
+    {
+      auto const r = reformulation(constrs, nr_threads);
+      REQUIRE(r.size() == expected.size());
+      for (std::size_t i = 0; i < r.size(); ++i)
+        REQUIRE(fmt::format("{}", r[i]) == expected[i]);
+    }
+  }
 }
 
@@ -3,7 +3,10 @@
 #include <miplib/solver.hpp>
 
 
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <thread>
 
 #include <fmt/ostream.h>
 
@@ -152,6 +155,60 @@ TEMPLATE_TEST_CASE_SIG(
 }
 
 
+TEMPLATE_TEST_CASE_SIG(
+  "Indicator constraint adaptive policy", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_indicator_constraint_policy(Solver::IndicatorConstraintPolicy::Adaptive);
+  solver.set_indicator_big_m_threshold(10);
+
+  Var z(solver, Var::Type::Binary, "z");
+  Var x(solver, Var::Type::Continuous, 0, 5, "x");
+  Var y(solver, Var::Type::Continuous, 0, 1000, "y");
+
+  auto small_m = (z == 1) >> (x <= 1);
+  auto large_m = (z == 1) >> (y <= 1);
+
+  REQUIRE(small_m.big_m() == 4);
+  REQUIRE(large_m.big_m() == 999);
+
+  solver.add(small_m);
+  solver.add(large_m);
+
+  auto const& stats = solver.indicator_constraint_stats();
+  if (solver.supports_indicator_constraint(large_m))
+  {
+    REQUIRE(stats.nr_reformulated == 1);
+    REQUIRE(stats.nr_native == 1);
+  }
+  else
+  {
+    REQUIRE(stats.nr_reformulated == 2);
+    REQUIRE(stats.nr_native == 0);
+  }
+
+  solver.add(z == 1);
+  auto [r, has_solution] = solver.maximize(x + y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() == Approx(1));
+  REQUIRE(y.value() == Approx(1));
+}
+
+
 TEMPLATE_TEST_CASE_SIG(
   "Lazy constraints", "[miplib]",
   ((miplib::Solver::Backend Backend), Backend),
@@ -224,13 +281,33 @@ TEMPLATE_TEST_CASE_SIG(
     REQUIRE(has_solution);
     REQUIRE(v1.value() + v2.value() == 1);
   }
+
+  SECTION("Test clone without lazy constraints")
+  {
+    Solver solver(Backend, false);
+
+    Var v1(solver, Var::Type::Integer, 0, 1, "v1");
+    Var v2(solver, Var::Type::Integer, 0, 1, "v2");
+
+    solver.add_lazy_constr_handler(LazyConstrHandler(std::make_shared<Handler>(solver, v1, v2)), true);
+
+    auto [clone, remapping] = solver.clone();
+    auto [r, has_solution] = clone.maximize(remapping.var(v1) + remapping.var(v2));
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(clone.get_objective_value() == Approx(2));
+
+    std::tie(r, has_solution) = solver.maximize(v1 + v2);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(solver.get_objective_value() == Approx(1));
+  }
 }
 
 TEMPLATE_TEST_CASE_SIG(
   "Solver remove constraints", "[miplib]",
   ((miplib::Solver::Backend Backend), Backend),
   miplib::Solver::Backend::Gurobi,
-  miplib::Solver::Backend::Scip
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
 )
 {
   using namespace miplib;
@@ -260,5 +337,1319 @@ TEMPLATE_TEST_CASE_SIG(
     solver.remove(c1);
     std::tie(r, has_solution) = solver.maximize(v1 + v2);    
     REQUIRE(v1.value() == 2);
+    REQUIRE(v2.value() == 1);
+
+    // the constraints posted after c1 can still be modified.
+    solver.set_rhs(c2, 2);
+    std::tie(r, has_solution) = solver.maximize(v1 + v2);
+    REQUIRE(v2.value() == 2);
+  }
+
+  SECTION("Test remove several constraints")
+  {
+    auto c1 = v1 <= 1;
+    auto c2 = v1 + v2 <= 3;
+    auto c3 = v2 <= 1;
+    solver.add(c1);
+    solver.add(c2);
+    solver.add(c3);
+    solver.remove(c1);
+    solver.remove(c3);
+    auto [r, has_solution] = solver.maximize(v1 + v2);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(solver.get_objective_value() == Approx(3));
+
+    solver.remove(c2);
+    std::tie(r, has_solution) = solver.maximize(v1 + v2);
+    REQUIRE(solver.get_objective_value() == Approx(4));
+  }
+
+  SECTION("Test remove constraints among many")
+  {
+    std::vector<Constr> constrs;
+    for (int i = 0; i < 8; ++i)
+    {
+      constrs.push_back(v1 + v2 <= 10 + i);
+      solver.add(constrs.back());
+    }
+    solver.remove(constrs[2]);
+    solver.remove(constrs[5]);
+    auto c = v2 <= 1;
+    solver.add(c);
+
+    // the constraints posted before and after the removed ones are
+    // still found.
+    solver.set_rhs(constrs[7], 2);
+    auto [r, has_solution] = solver.maximize(v1 + v2);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(solver.get_objective_value() == Approx(2));
+
+    solver.remove(constrs[7]);
+    solver.set_rhs(constrs[0], 3);
+    std::tie(r, has_solution) = solver.maximize(v1 + v2);
+    REQUIRE(solver.get_objective_value() == Approx(3));
+    REQUIRE(v2.value() == Approx(1));
+
+    solver.set_rhs(c, 2);
+    std::tie(r, has_solution) = solver.maximize(v1 + v2);
+    REQUIRE(solver.get_objective_value() == Approx(3));
+  }
+}
+
+
+TEMPLATE_TEST_CASE_SIG(
+  "Range constraints", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Continuous, 0, 10, "x");
+  Var y(solver, Var::Type::Continuous, 0, 10, "y");
+
+  auto c = range(2, x + y + 1, 5);
+  REQUIRE(c.type() == Constr::Range);
+  REQUIRE(c.width() == 3);
+  solver.add(c);
+
+  SECTION("Upper side")
+  {
+    auto [r, has_solution] = solver.maximize(x + 2 * y);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(y.value() == Approx(4));
+  }
+
+  SECTION("Lower side")
+  {
+    auto [r, has_solution] = solver.minimize(2 * x + y);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(x.value() == Approx(0).margin(1e-6));
+    REQUIRE(y.value() == Approx(1));
+  }
+}
+
+
+TEMPLATE_TEST_CASE_SIG(
+  "SOS constraints", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x1(solver, Var::Type::Continuous, 0, 1, "x1");
+  Var x2(solver, Var::Type::Continuous, 0, 1, "x2");
+  Var x3(solver, Var::Type::Continuous, 0, 1, "x3");
+
+  SECTION("SOS1")
+  {
+    SOSConstr c(solver, SOSConstr::SOS1, {x1, x2, x3});
+    REQUIRE(solver.supports_sos_constraint(c));
+    solver.add(c);
+    auto [r, has_solution] = solver.maximize(x1 + 2 * x2 + 3 * x3);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(solver.get_objective_value() == Approx(3));
+  }
+
+  SECTION("SOS2 ordered by weights")
+  {
+    SOSConstr c(solver, SOSConstr::SOS2, {x1, x2, x3}, {3, 1, 2});
+    REQUIRE(c.vars()[0].is_same(x2));
+    REQUIRE(c.weights() == std::vector<double>{1, 2, 3});
+    solver.add(c);
+    auto [r, has_solution] = solver.maximize(3 * x1 + x2 + 2 * x3);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(solver.get_objective_value() == Approx(5));
+    REQUIRE(x2.value() == Approx(0).margin(1e-6));
+  }
+
+  SECTION("SOS2 reformulation")
+  {
+    Var y(solver, Var::Type::Continuous, -1, 1, "y");
+    SOSConstr c(solver, SOSConstr::SOS2, {y, x1, x2, x3});
+    REQUIRE(c.has_reformulation());
+    for (auto const& ctr: c.reformulation())
+      solver.add(ctr);
+    auto [r, has_solution] = solver.minimize(y - x1 - x2 - 2 * x3);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(solver.get_objective_value() == Approx(-3));
+    REQUIRE(y.value() == Approx(0).margin(1e-6));
+  }
+}
+
+
+TEMPLATE_TEST_CASE_SIG(
+  "General constraints", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Continuous, -3, 4, "x");
+  Var y(solver, Var::Type::Continuous, -3, 4, "y");
+  Var r(solver, Var::Type::Continuous, -10, 10, "r");
+
+  SECTION("Max")
+  {
+    GenConstr c(solver, GenConstr::Max, r, {x, y});
+    REQUIRE(c.big_m() == 7);
+    solver.add(c);
+    solver.add(x + y >= 3);
+    auto [status, has_solution] = solver.minimize(r);
+    REQUIRE(status == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(r.value() == Approx(1.5));
+  }
+
+  SECTION("Max reformulated")
+  {
+    solver.set_general_constraint_policy(Solver::GeneralConstraintPolicy::Reformulate);
+    solver.add(GenConstr(solver, GenConstr::Max, r, {x, y}));
+    solver.add(x + y >= 3);
+    auto [status, has_solution] = solver.minimize(r);
+    REQUIRE(status == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(r.value() == Approx(1.5));
+  }
+
+  SECTION("Min")
+  {
+    solver.add(GenConstr(solver, GenConstr::Min, r, {x, y}));
+    solver.add(x + y <= 1);
+    auto [status, has_solution] = solver.maximize(r);
+    REQUIRE(status == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(r.value() == Approx(0.5));
+  }
+
+  SECTION("Abs")
+  {
+    solver.add(GenConstr(solver, GenConstr::Abs, r, {x}));
+    auto [status, has_solution] = solver.maximize(r - y);
+    REQUIRE(status == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(r.value() == Approx(4));
+    REQUIRE(x.value() == Approx(4));
+    solver.add(x <= -1);
+    std::tie(status, has_solution) = solver.minimize(r);
+    REQUIRE(status == Solver::Result::Optimal);
+    REQUIRE(r.value() == Approx(1));
+  }
+
+  SECTION("And/Or")
+  {
+    Var b1(solver, Var::Type::Binary);
+    Var b2(solver, Var::Type::Binary);
+    Var c(solver, Var::Type::Binary);
+    Var d(solver, Var::Type::Binary);
+    REQUIRE_THROWS(GenConstr(solver, GenConstr::And, c, {b1, x}));
+    solver.add(GenConstr(solver, GenConstr::And, c, {b1, b2}));
+    solver.add(GenConstr(solver, GenConstr::Or, d, {b1, b2}));
+    solver.add(b1 == 1);
+    solver.add(b2 == 0);
+    auto [status, has_solution] = solver.maximize(c - d);
+    REQUIRE(status == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(c.value() == Approx(0).margin(1e-6));
+    REQUIRE(d.value() == Approx(1));
+  }
+}
+
+
+TEMPLATE_TEST_CASE_SIG(
+  "Piecewise linear constraints", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Continuous, -10, 10, "x");
+  Var y(solver, Var::Type::Continuous, -100, 100, "y");
+
+  PwlConstr c(solver, x, y, {0, 1, 3, 4, 6}, {0, 2, 3, 0, 1});
+
+  auto check = [&]() {
+    auto [r, has_solution] = solver.maximize(y);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(y.value() == Approx(3));
+    REQUIRE(x.value() == Approx(3));
+
+    // non-convex part of f
+    solver.add(x >= 2);
+    std::tie(r, has_solution) = solver.minimize(y);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(y.value() == Approx(0).margin(1e-6));
+    REQUIRE(x.value() == Approx(4));
+
+    solver.add(x == 5);
+    std::tie(r, has_solution) = solver.minimize(y);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(y.value() == Approx(0.5));
+  };
+
+  SECTION("Default")
+  {
+    solver.add(c);
+    check();
+  }
+
+  SECTION("SOS2 encoding")
+  {
+    solver.set_pwl_constraint_encoding(PwlConstr::Encoding::SOS2);
+    solver.add(c);
+    check();
+  }
+
+  SECTION("Logarithmic encoding")
+  {
+    solver.set_pwl_constraint_encoding(PwlConstr::Encoding::Logarithmic);
+    solver.add(c);
+    check();
+  }
+}
+
+
+TEMPLATE_TEST_CASE_SIG(
+  "Semi-continuous variables", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
   }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::SemiContinuous, 2, 5, "x");
+  Var y(solver, Var::Type::SemiInteger, 2, 5, "y");
+
+  REQUIRE(x.type() == Var::Type::SemiContinuous);
+  REQUIRE(y.type() == Var::Type::SemiInteger);
+  REQUIRE(x.lb() == 2);
+  REQUIRE(x.domain_lb() == 0);
+  REQUIRE(x.domain_ub() == 5);
+  REQUIRE((x + y).must_be_integer() == false);
+  REQUIRE(Expr(y).must_be_integer());
+
+  SECTION("Zero")
+  {
+    solver.add(x + y <= 1.5);
+    auto [r, has_solution] = solver.maximize(x + y);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(x.value() == Approx(0).margin(1e-6));
+    REQUIRE(y.value() == Approx(0).margin(1e-6));
+  }
+
+  SECTION("Within bounds")
+  {
+    solver.add(x + y <= 4.5);
+    solver.add(x + y >= 1);
+    auto [r, has_solution] = solver.maximize(x + 2 * y);
+    REQUIRE(r == Solver::Result::Optimal);
+    REQUIRE(has_solution);
+    REQUIRE(y.value() == Approx(4));
+    REQUIRE(x.value() == Approx(0).margin(1e-6));
+  }
+}
+
+
+TEMPLATE_TEST_CASE_SIG(
+  "Linearization of products with binaries", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_non_convex_policy(Solver::NonConvexPolicy::Linearize);
+
+  Var b(solver, Var::Type::Binary, "b");
+  Var y(solver, Var::Type::Binary, "y");
+  Var x(solver, Var::Type::Continuous, -2, 10, "x");
+
+  // b = 1 -> x <= 4
+  solver.add(x * b <= 4);
+
+  auto [r, has_solution] = solver.maximize(x + 10 * b + 2 * y - 3 * b * y + b * b);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(solver.get_objective_value() == Approx(15));
+  REQUIRE(b.value() == Approx(1));
+  REQUIRE(y.value() == Approx(0).margin(1e-6));
+  REQUIRE(x.value() == Approx(4));
+
+  // a product whose definitions were rolled back is linearized anew.
+  solver.push();
+  solver.add(x * y <= 1);
+  solver.pop();
+  solver.add(x * y <= 1);
+
+  std::tie(r, has_solution) = solver.maximize(x + 10 * y + 10 * b);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(21));
+  REQUIRE(x.value() == Approx(1));
+
+  // the definitions follow the domain of x.
+  x.set_ub(20);
+  std::tie(r, has_solution) = solver.maximize(x + y + b);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+  REQUIRE(x.value() == Approx(20));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "McCormick relaxation of bilinear terms", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_non_convex_policy(Solver::NonConvexPolicy::McCormick);
+  solver.set_refinement_tolerance(1e-2);
+
+  Var x(solver, Var::Type::Continuous, 0, 4, "x");
+  Var y(solver, Var::Type::Continuous, 0, 4, "y");
+
+  // x = 3.25, y = 0.75 satisfies the initial envelope.
+  solver.add(x + y <= 4);
+  solver.add(x * y >= 3);
+
+  auto [r, has_solution] = solver.maximize(x - y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() * y.value() == Approx(3).epsilon(1e-2));
+  // the relaxation bounds the optimum x = 3, y = 1.
+  REQUIRE(solver.get_objective_value() >= 2 - 1e-6);
+  REQUIRE(solver.get_objective_value() == Approx(2).epsilon(1e-2));
+
+  // the envelopes refined within a checkpoint are replaced, and restored
+  // once it is rolled back.
+  solver.push();
+  std::tie(r, has_solution) = solver.maximize(y - x);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(2).epsilon(1e-2));
+  solver.pop();
+
+  solver.set_refinement_max_iterations(1);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(x.value() * y.value() == Approx(3).epsilon(1e-2));
+  REQUIRE(solver.get_objective_value() == Approx(2).epsilon(1e-2));
+
+  // the envelopes follow the domains of the variables.
+  solver.set_refinement_max_iterations(100);
+  Var u(solver, Var::Type::Continuous, 0, 2, "u");
+  Var v(solver, Var::Type::Continuous, 0, 2, "v");
+  solver.add(u * v >= 3);
+  std::tie(r, has_solution) = solver.maximize(u - v);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(0.5).epsilon(1e-2));
+
+  u.set_ub(4);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(u.value() * v.value() == Approx(3).epsilon(1e-2));
+  REQUIRE(solver.get_objective_value() == Approx(3.25).epsilon(1e-2));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Convexity detection", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_non_convex_policy(Solver::NonConvexPolicy::Auto);
+
+  Var x(solver, Var::Type::Continuous, -10, 10, "x");
+  Var y(solver, Var::Type::Continuous, -10, 10, "y");
+  Var b(solver, Var::Type::Binary, "b");
+
+  REQUIRE((x * x + y * y - x * y).is_convex());
+  // positive semidefinite but singular.
+  REQUIRE((x * x - 2 * x * y + y * y).is_convex());
+  REQUIRE(!(x * y).is_convex());
+  REQUIRE(!(x * x - 3 * x * y + y * y).is_convex());
+  REQUIRE((x * x + y * y <= 4).is_convex());
+  REQUIRE(!(x * x + y * y >= 4).is_convex());
+  REQUIRE(!(x * x == 4).is_convex());
+
+  if (!solver.supports_quadratic_objective())
+    return;
+
+  // b * x only becomes convex once linearized.
+  solver.add(b * x + x * x <= 3);
+  auto [r, has_solution] = solver.minimize((x - 1) * (x - 1) + (y - 2) * (y - 2) - b);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() == Approx(1).margin(1e-4));
+  REQUIRE(y.value() == Approx(2).margin(1e-4));
+  REQUIRE(b.value() == Approx(1));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Tangent approximation of separable quadratic objectives", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_quadratic_objective_tangents(3);
+  solver.set_refinement_max_iterations(30);
+  solver.set_refinement_tolerance(1e-6);
+
+  Var x(solver, Var::Type::Continuous, -5, 5, "x");
+  Var y(solver, Var::Type::Continuous, -5, 5, "y");
+
+  solver.add(x + y <= 2);
+
+  // (x - 2)^2 + (y - 1)^2 - 5, optimum at x = 1.5, y = 0.5.
+  auto [r, has_solution] = solver.minimize(x * x + y * y - 4 * x - 2 * y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() == Approx(1.5).margin(1e-3));
+  REQUIRE(y.value() == Approx(0.5).margin(1e-3));
+  REQUIRE(solver.get_objective_value() == Approx(-4.5).margin(1e-3));
+
+  // the terms are reused by later objectives along with their tangents,
+  // those refined above making a single solve exact.
+  std::tie(r, has_solution) = solver.minimize(x * x + 2 * x);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(x.value() == Approx(-1).margin(1e-3));
+
+  solver.set_refinement_max_iterations(1);
+  std::tie(r, has_solution) = solver.minimize(x * x + y * y - 4 * x - 2 * y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(-4.5).margin(1e-3));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Common subexpression extraction", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  std::vector<Var> fs;
+  for (std::size_t i = 0; i < 4; ++i)
+    fs.emplace_back(solver, Var::Type::Continuous, 0, 10);
+  Var x1(solver, Var::Type::Continuous, 0, 10, "x1");
+  Var x2(solver, Var::Type::Continuous, 0, 10, "x2");
+  Var x3(solver, Var::Type::Continuous, 0, 10, "x3");
+
+  Expr flow = fs[0] + fs[1] + fs[2] + fs[3];
+  auto const constrs = extract_common_subexpressions({
+    flow + x1 <= 10,
+    flow + x2 <= 8,
+    flow - x3 <= 5
+  });
+
+  // the flow is replaced by a single variable in each row.
+  REQUIRE(constrs.size() == 4);
+  for (std::size_t i = 0; i < 3; ++i)
+    REQUIRE(constrs[i].expr().linear_vars().size() == 2);
+  REQUIRE(constrs[3].type() == Constr::Equal);
+
+  for (auto const& c: constrs)
+    solver.add(c);
+
+  auto [r, has_solution] = solver.maximize(3 * flow + x1 + x2 - x3);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(solver.get_objective_value() == Approx(23));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Constraint coefficient and rhs modification", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Continuous, 0, 3, "x");
+  Var y(solver, Var::Type::Continuous, 0, 10, "y");
+
+  auto c = x + y <= 4;
+  solver.add(c);
+  solver.set_objective(Solver::Sense::Maximize, x + y);
+
+  auto [r, has_solution] = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(4));
+
+  // x + 2 * y <= 6
+  solver.set_coeff(c, y, 2);
+  solver.set_rhs(c, 6);
+  REQUIRE(c.expr().constant() == Approx(-6));
+
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() == Approx(3));
+  REQUIRE(y.value() == Approx(1.5));
+  REQUIRE(solver.get_objective_value() == Approx(4.5));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Column addition", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Continuous, 0, 10, "x");
+  auto c1 = x <= 4;
+  auto c2 = x >= 1;
+  solver.add(c1);
+  solver.add(c2);
+  solver.set_objective(Solver::Sense::Maximize, x);
+
+  auto [r, has_solution] = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(4));
+
+  // maximize x + 2 * z st x + z <= 4, x >= 1
+  auto z = solver.add_column(Var::Type::Continuous, 0, 10, 2, {c1}, {1}, "z");
+  REQUIRE(c1.expr().linear_vars().size() == 2);
+
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() == Approx(1));
+  REQUIRE(z.value() == Approx(3));
+  REQUIRE(solver.get_objective_value() == Approx(7));
+
+  // the objective coefficient of the column is replaced as any other.
+  solver.set_objective(Solver::Sense::Maximize, x);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(4));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Dual values and reduced costs", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Continuous, 0, 10, "x");
+  Var y(solver, Var::Type::Continuous, 0, 10, "y");
+  Var z(solver, Var::Type::Continuous, 0, 10, "z");
+  // -x - y - z <= -2, x <= 1.5 (a singleton row, which presolve would
+  // turn into a bound)
+  auto c1 = x + y + z >= 2;
+  auto c2 = x <= 1.5;
+  solver.add(c1);
+  solver.add(c2);
+  solver.set_objective(Solver::Sense::Minimize, x + 2 * y + 3 * z);
+
+  auto [r, has_solution] = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(solver.get_objective_value() == Approx(2.5));
+
+  auto const duals = solver.duals({c1, c2});
+  REQUIRE(duals.size() == 2);
+  REQUIRE(duals[0] == Approx(-2));
+  REQUIRE(duals[1] == Approx(-1));
+  REQUIRE(c2.dual() == Approx(-1));
+
+  auto const reduced_costs = solver.reduced_costs({x, y, z});
+  REQUIRE(reduced_costs.size() == 3);
+  REQUIRE(reduced_costs[0] == Approx(0).margin(1e-6));
+  REQUIRE(reduced_costs[1] == Approx(0).margin(1e-6));
+  REQUIRE(reduced_costs[2] == Approx(1));
+  REQUIRE(z.reduced_cost() == Approx(1));
+
+  // rows removed before and after a solve leave the others in place.
+  Solver other(Backend, false);
+  Var u(other, Var::Type::Continuous, 0, 10, "u");
+  Var v(other, Var::Type::Continuous, 0, 10, "v");
+  auto d1 = u + v <= 30;
+  auto d2 = u + v >= 2;
+  auto d3 = u + v <= 20;
+  auto d4 = u <= 1.5;
+  for (auto const& d: {d1, d2, d3, d4})
+    other.add(d);
+  other.remove(d1);
+  other.set_objective(Solver::Sense::Minimize, u + 2 * v);
+
+  std::tie(r, has_solution) = other.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(other.get_objective_value() == Approx(2.5));
+
+  // u + v >= 3
+  other.remove(d3);
+  other.set_rhs(d2, -3);
+  std::tie(r, has_solution) = other.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(other.get_objective_value() == Approx(4.5));
+  REQUIRE(d2.dual() == Approx(-2));
+  REQUIRE(d4.dual() == Approx(-1));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Relaxation solve", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  auto c1 = 6 * x + 4 * y <= 24;
+  auto c2 = x + 2 * y <= 6;
+  solver.add(c1);
+  solver.add(c2);
+  solver.set_objective(Solver::Sense::Maximize, 5 * x + 4 * y);
+
+  auto [r, has_solution] = solver.solve_relaxation();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() == Approx(3));
+  REQUIRE(y.value() == Approx(1.5));
+  REQUIRE(solver.get_objective_value() == Approx(21));
+
+  // integrality is restored.
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(x.type() == Var::Type::Integer);
+  REQUIRE(x.value() == Approx(4));
+  REQUIRE(y.value() == Approx(0).margin(1e-6));
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  // the relaxation with fixed integers gives the duals of the solution.
+  std::tie(r, has_solution) = solver.solve_relaxation(true);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+  REQUIRE(c2.dual() == Approx(0).margin(1e-6));
+
+  // relaxed variables keep their declared type and bounds, and a bound
+  // changed before the next solve is kept.
+  std::tie(r, has_solution) = solver.solve_relaxation();
+  REQUIRE(x.type() == Var::Type::Integer);
+  REQUIRE(x.ub() == Approx(10));
+  x.set_ub(3);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(x.value() == Approx(3));
+  REQUIRE(solver.get_objective_value() == Approx(19));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "LP basis", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_basis_carry_forward(true);
+
+  Var x(solver, Var::Type::Continuous, 0, 10, "x");
+  Var y(solver, Var::Type::Continuous, 0, 10, "y");
+  auto c1 = x + 2 * y <= 4;
+  solver.add(c1);
+  solver.add(3 * x + y <= 6);
+  solver.set_objective(Solver::Sense::Maximize, x + y);
+
+  auto [r, has_solution] = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(2.8));
+
+  auto const basis = solver.get_basis();
+  REQUIRE(basis.vars.size() == 2);
+  REQUIRE(basis.constrs.size() == 2);
+  REQUIRE(basis.vars[0] == Solver::BasisStatus::Basic);
+  REQUIRE(basis.vars[1] == Solver::BasisStatus::Basic);
+  REQUIRE(basis.constrs[0] != Solver::BasisStatus::Basic);
+  REQUIRE(basis.constrs[1] != Solver::BasisStatus::Basic);
+  REQUIRE_THROWS(solver.set_basis({{Solver::BasisStatus::Basic}, {}}));
+
+  // the same basis remains optimal, carried forward or set explicitly.
+  solver.set_objective(Solver::Sense::Maximize, 2 * x + 3 * y);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(6.8));
+  REQUIRE(std::abs(solver.duals({c1})[0]) == Approx(1.4));
+
+  // an explicitly set basis is not replaced by the carried one.
+  solver.set_basis(basis);
+  solver.set_objective(Solver::Sense::Maximize, x + y);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(x.value() == Approx(1.6));
+  REQUIRE(y.value() == Approx(1.2));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Automatic warm start", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_auto_warm_start(true);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  solver.add(6 * x + 4 * y <= 24);
+  solver.add(x + 2 * y <= 6);
+  solver.set_objective(Solver::Sense::Maximize, 5 * x + 4 * y);
+
+  auto [r, has_solution] = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  // the incumbent, completed by z = 0, remains feasible.
+  Var z(solver, Var::Type::Integer, 0, 3, "z");
+  solver.add(x + z <= 5);
+  solver.set_objective(Solver::Sense::Maximize, 5 * x + 4 * y + 2 * z);
+
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
+  REQUIRE(x.value() == Approx(2));
+  REQUIRE(y.value() == Approx(2));
+  REQUIRE(z.value() == Approx(3));
+  REQUIRE(solver.get_objective_value() == Approx(24));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Parametric sweep", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  // maximize x + y st x + y <= budget, the optimum being min(budget, 6).
+  auto const build = [](Solver& solver) {
+    Var x(solver, Var::Type::Integer, 0, 3);
+    Var y(solver, Var::Type::Continuous, 0, 3);
+    auto budget = x + y <= 0;
+    solver.add(budget);
+    solver.set_objective(Solver::Sense::Maximize, x + y);
+    return std::function<void(double)>([&solver, budget](double value) {
+      solver.set_rhs(budget, value);
+    });
+  };
+  std::vector<double> const budgets = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  Solver solver(Backend, false);
+  std::vector<double> objective_values(budgets.size());
+  solver.sweep(build(solver), budgets, [&](Solver const&, Solver::SweepStep const& step) {
+    REQUIRE(step.result == Solver::Result::Optimal);
+    objective_values[step.index] = step.objective_value;
+  });
+  for (std::size_t i = 0; i < budgets.size(); ++i)
+    REQUIRE(objective_values[i] == Approx(std::min(budgets[i], 6.0)));
+
+  std::vector<double> parallel_objective_values(budgets.size());
+  Solver::sweep(
+    Backend,
+    build,
+    budgets,
+    [&](Solver const&, Solver::SweepStep const& step) {
+      parallel_objective_values[step.index] = step.objective_value;
+    },
+    3
+  );
+  for (std::size_t i = 0; i < budgets.size(); ++i)
+    REQUIRE(parallel_objective_values[i] == Approx(objective_values[i]));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Reoptimization", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+  solver.set_reoptimizing(true);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  solver.add(6 * x + 4 * y <= 24);
+  solver.add(x + 2 * y <= 6);
+
+  auto [r, has_solution] = solver.maximize(5 * x + 4 * y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  // objective change.
+  std::tie(r, has_solution) = solver.maximize(x + 4 * y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(12));
+
+  // restriction of the feasible region.
+  y.set_ub(2);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(10));
+
+  // enlargement of the feasible region.
+  y.set_ub(10);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(12));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Objective replacement", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  solver.add(6 * x + 4 * y <= 24);
+  solver.add(x + 2 * y <= 6);
+
+  auto [r, has_solution] = solver.maximize(3 * x + y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(12));
+
+  // the coefficient of x is reset.
+  std::tie(r, has_solution) = solver.maximize(y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(3));
+  REQUIRE(y.value() == Approx(3));
+
+  // and so is the coefficient of a variable destroyed since.
+  {
+    Var z(solver, Var::Type::Continuous, 0, 1, "z");
+    std::tie(r, has_solution) = solver.maximize(y + 10 * z);
+    REQUIRE(solver.get_objective_value() == Approx(13));
+  }
+  std::tie(r, has_solution) = solver.maximize(y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(3));
+
+  if (!solver.supports_quadratic_objective())
+    return;
+
+  std::tie(r, has_solution) = solver.minimize((x - 1) * (x - 1) + (y - 1) * (y - 1));
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(0).margin(1e-6));
+
+  // replacement of a quadratic objective by another one.
+  std::tie(r, has_solution) = solver.minimize((x - 3) * (x - 3) + (y - 3) * (y - 3));
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(2));
+  REQUIRE(x.value() == Approx(2));
+  REQUIRE(y.value() == Approx(2));
+
+  // and back to a linear one.
+  std::tie(r, has_solution) = solver.maximize(y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(3));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Clone", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  auto c = 6 * x + 4 * y <= 24;
+  solver.add(c);
+  solver.add(x + 2 * y <= 6);
+  solver.set_objective(Solver::Sense::Maximize, 5 * x + 4 * y);
+
+  auto [clone, remapping] = solver.clone();
+  auto x_copy = remapping.var(x);
+  auto y_copy = remapping.var(y);
+  clone.set_rhs(remapping.constr(c), 12);
+  clone.add(y_copy <= 1);
+
+  // both are solved concurrently, independently.
+  auto clone_result = std::async(std::launch::async, [&clone = clone]() {
+    return clone.solve();
+  });
+  auto [r, has_solution] = solver.solve();
+  auto [clone_r, clone_has_solution] = clone_result.get();
+
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+  REQUIRE(x.value() == Approx(4));
+  REQUIRE(clone_r == Solver::Result::Optimal);
+  REQUIRE(clone.get_objective_value() == Approx(10));
+  REQUIRE(x_copy.value() == Approx(2));
+
+  // the objective of the clone is replaced as a whole.
+  std::tie(clone_r, clone_has_solution) = clone.maximize(y_copy);
+  REQUIRE(clone_r == Solver::Result::Optimal);
+  REQUIRE(clone.get_objective_value() == Approx(1));
+
+  // the source keeps its relaxation and solution, the clone is integer.
+  std::tie(r, has_solution) = solver.solve_relaxation();
+  REQUIRE(r == Solver::Result::Optimal);
+  auto [relaxed_clone, relaxed_remapping] = solver.clone();
+  REQUIRE(x.value() == Approx(3));
+  REQUIRE(y.value() == Approx(1.5));
+  REQUIRE(relaxed_remapping.var(x).type() == Var::Type::Integer);
+  std::tie(clone_r, clone_has_solution) = relaxed_clone.solve();
+  REQUIRE(clone_r == Solver::Result::Optimal);
+  REQUIRE(relaxed_clone.get_objective_value() == Approx(20));
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Checkpoints", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  solver.add(6 * x + 4 * y <= 24);
+  solver.add(x + 2 * y <= 6);
+
+  auto [r, has_solution] = solver.maximize(5 * x + 4 * y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  solver.push();
+  x.set_ub(2);
+  solver.add(y <= 1);
+  std::tie(r, has_solution) = solver.maximize(x + 4 * y);
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(6));
+
+  // nested checkpoint.
+  solver.push();
+  solver.add(x <= 1);
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(solver.get_objective_value() == Approx(5));
+  solver.pop();
+
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(6));
+
+  solver.pop();
+  REQUIRE(x.ub() == Approx(10));
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  // the popped bounds outlast a relaxation.
+  solver.push();
+  x.set_ub(2);
+  std::tie(r, has_solution) = solver.solve_relaxation();
+  REQUIRE(r == Solver::Result::Optimal);
+  solver.pop();
+  std::tie(r, has_solution) = solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  REQUIRE_THROWS_AS(solver.pop(), std::logic_error);
+}
+
+TEMPLATE_TEST_CASE_SIG(
+  "Asynchronous solve", "[miplib]",
+  ((miplib::Solver::Backend Backend), Backend),
+  miplib::Solver::Backend::Gurobi,
+  miplib::Solver::Backend::Scip,
+  miplib::Solver::Backend::Lpsolve
+)
+{
+  using namespace miplib;
+
+  if (!Solver::backend_is_available(Backend))
+  {
+    WARN(fmt::format("Skipped since {} is not available.", Backend));
+    return;
+  }
+
+  Solver solver(Backend, false);
+
+  Var x(solver, Var::Type::Integer, 0, 10, "x");
+  Var y(solver, Var::Type::Integer, 0, 10, "y");
+  solver.add(6 * x + 4 * y <= 24);
+  solver.add(x + 2 * y <= 6);
+  solver.set_objective(Solver::Sense::Maximize, 5 * x + 4 * y);
+
+  auto result = solver.solve_async();
+  auto [r, has_solution] = result.get();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(solver.get_objective_value() == Approx(20));
+
+  // a cancelled token interrupts the solves started with it.
+  Solver::CancellationToken token;
+  REQUIRE(!token.is_cancelled());
+  token.cancel();
+  REQUIRE(token.is_cancelled());
+  std::tie(r, has_solution) = solver.solve_async(token).get();
+  REQUIRE(r == Solver::Result::Interrupted);
+  REQUIRE(!has_solution);
+
+  // a running solve is interrupted (a market split instance, far from
+  // solved by the time it is cancelled).
+  Solver hard_solver(Backend, false);
+  std::vector<Var> xs;
+  for (int j = 0; j < 40; ++j)
+    xs.emplace_back(hard_solver, Var::Type::Binary);
+  unsigned int seed = 1;
+  auto const next_coeff = [&]() {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<int>((seed >> 16) % 100);
+  };
+  std::vector<Constr> constrs;
+  for (int i = 0; i < 5; ++i)
+  {
+    Expr e;
+    int sum = 0;
+    for (auto const& x: xs)
+    {
+      auto const coeff = next_coeff();
+      e += coeff * x;
+      sum += coeff;
+    }
+    constrs.push_back(e == sum / 2);
+    hard_solver.add(constrs.back());
+  }
+  Expr obj;
+  for (auto const& x: xs)
+    obj += next_coeff() * x;
+  hard_solver.set_objective(Solver::Sense::Maximize, obj);
+
+  Solver::CancellationToken running_token;
+  auto running = hard_solver.solve_async(running_token);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  running_token.cancel();
+  std::tie(r, has_solution) = running.get();
+  REQUIRE(r == Solver::Result::Interrupted);
+
+  // the cancellation does not carry over to the next solve.
+  for (auto const& constr: constrs)
+    hard_solver.remove(constr);
+  std::tie(r, has_solution) = hard_solver.solve();
+  REQUIRE(r == Solver::Result::Optimal);
+  REQUIRE(has_solution);
 }